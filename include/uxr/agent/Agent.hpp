@@ -17,10 +17,12 @@
 
 #include <uxr/agent/visibility.hpp>
 #include <uxr/agent/middleware/Middleware.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
 
 #include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -553,6 +555,20 @@ public:
      */
     UXR_AGENT_EXPORT void set_verbose_level(uint8_t verbose_level);
 
+    /**
+     * @brief Sets the CPU affinity and the scheduling priority of the agent threads of the given kind.
+     *        The settings are process-wide and apply to the threads started afterwards,
+     *        so they shall be set before starting the agent.
+     * @param thread_kind   The kind of threads.
+     * @param cpus          The CPUs on which the threads may run, any of them if empty.
+     * @param priority      The SCHED_FIFO priority, from 1 to 99, or 0 to keep the default scheduling policy.
+     * @return true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_thread_settings(
+            ThreadKind thread_kind,
+            const std::vector<uint16_t>& cpus,
+            uint8_t priority);
+
     /**
      * @brief Sets a callback function for an specific create/delete middleware entity operation.
      *        Note that not some middlewares might not implement every defined operation, or even
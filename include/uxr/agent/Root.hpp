@@ -17,10 +17,11 @@
 
 #include <uxr/agent/client/ProxyClient.hpp>
 
+#include <atomic>
 #include <thread>
 #include <memory>
-#include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace eprosima{
 namespace uxr{
@@ -45,20 +46,62 @@ public:
 
     dds::xrce::ResultStatus delete_client(const dds::xrce::ClientKey& client_key);
 
+    /**
+     * @brief Looks a client up in the snapshot of the clients cached by the calling thread,
+     *        which only takes the registry lock to refresh the snapshot after a change.
+     * @param client_key    The key of the client.
+     * @return  The client, or nullptr if it does not exist.
+     */
     std::shared_ptr<ProxyClient> get_client(const dds::xrce::ClientKey& client_key);
 
+    /**
+     * @brief Iterates over the clients in round-robin. Each pass goes through the clients as they
+     *        were when the pass started, and is followed by a call which returns false.
+     */
     bool get_next_client(std::shared_ptr<ProxyClient>& next_client);
 
     bool load_config_file(const std::string& file_path);
 
     void set_verbose_level(uint8_t verbose_level);
 
+    /**
+     * @brief Sets the stream depths of the clients created from now on, unless they ask for others.
+     */
+    void set_stream_depths(const StreamDepths& stream_depths);
+
+    /**
+     * @brief Sets the deepest streams the clients created from now on may ask for,
+     *        never below the default stream depths.
+     */
+    void set_max_stream_depth(uint16_t max_stream_depth);
+
     void reset();
 
 private:
+    /* Clients by raw client key. */
+    typedef std::unordered_map<uint32_t, std::shared_ptr<ProxyClient>> ClientMap;
+
+    /* Returns the snapshot cached by the calling thread, refreshed if the registry has changed.
+       The reference is valid until the next call from the same thread. */
+    const std::shared_ptr<const ClientMap>& load_clients();
+
+    /* Publishes a new snapshot. It must be called with the registry lock held. */
+    void store_clients(std::shared_ptr<const ClientMap> clients);
+
+private:
+    /* Serializes the changes of the registry, which are published as a new snapshot of the clients
+       (copy-on-write) along with a new version. Readers keep a per-thread copy of the snapshot and
+       only check the version, unique process-wide, to know whether it is current. */
     std::mutex mtx_;
-    std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>> clients_;
-    std::map<dds::xrce::ClientKey, std::shared_ptr<ProxyClient>>::iterator current_client_;
+    std::shared_ptr<const ClientMap> clients_;
+    std::atomic<uint64_t> version_;
+    StreamDepths stream_depths_;
+    uint16_t max_stream_depth_;
+
+    /* Round-robin iteration of get_next_client, apart from the registry lock. */
+    std::mutex iteration_mtx_;
+    std::shared_ptr<const ClientMap> iteration_clients_;
+    ClientMap::const_iterator current_client_;
 };
 
 } // uxr
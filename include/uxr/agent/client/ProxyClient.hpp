@@ -36,7 +36,9 @@ public:
     explicit ProxyClient(
             const dds::xrce::CLIENT_Representation& representation,
             Middleware::Kind middleware_kind = Middleware::Kind(0),
-            std::unordered_map<std::string, std::string>&& properties = {});
+            std::unordered_map<std::string, std::string>&& properties = {},
+            const StreamDepths& stream_depths = StreamDepths{},
+            uint16_t max_stream_depth = DEFAULT_MAX_CLIENT_STREAM_DEPTH);
 
     ~ProxyClient() = default;
 
@@ -65,11 +67,13 @@ public:
 
     dds::xrce::SessionId get_session_id() const { return representation_.session_id(); }
 
+    uint16_t get_output_weight() const { return output_weight_; }
+
     void release();
 
     Session& session();
 
-    State get_state();
+    State get_state(std::chrono::milliseconds dead_time = CLIENT_DEAD_TIME);
 
     void update_state();
 
@@ -134,6 +138,7 @@ private:
     State state_;
     std::chrono::time_point<std::chrono::steady_clock> timestamp_;
     std::unordered_map<std::string, std::string> properties_;
+    uint16_t output_weight_;
 };
 
 } // namespace uxr
@@ -18,9 +18,11 @@
 #include <uxr/agent/client/session/SessionInfo.hpp>
 #include <uxr/agent/client/session/stream/InputStream.hpp>
 #include <uxr/agent/client/session/stream/OutputStream.hpp>
-#include <uxr/agent/utils/SharedMutex.hpp>
+#include <uxr/agent/client/session/stream/StreamTable.hpp>
+#include <uxr/agent/message/ControlMessages.hpp>
 
-#include <unordered_map>
+#include <array>
+#include <atomic>
 #include <memory>
 
 namespace eprosima {
@@ -44,10 +46,25 @@ inline bool is_reliable_stream(dds::xrce::StreamId stream_id)
 class Session
 {
 public:
-    Session(const SessionInfo& info)
+    Session(
+            const SessionInfo& info,
+            const StreamDepths& depths = StreamDepths{})
         : session_info_(info)
-        , none_ostream_{}
-    {}
+        , depths_(depths)
+        , control_messages_(info)
+        , none_istream_(depths.best_effort)
+        , best_effort_istreams_(depths.best_effort)
+        , reliable_istreams_(depths.reliable)
+        , none_ostream_(depths.best_effort)
+        , best_effort_ostreams_(depths.best_effort)
+        , reliable_ostreams_(depths.reliable)
+        , unacked_streams_()
+    {
+        for (std::atomic<uint64_t>& word : unacked_streams_)
+        {
+            word.store(0, std::memory_order_relaxed);
+        }
+    }
 
     ~Session() = default;
 
@@ -77,6 +94,10 @@ public:
             dds::xrce::StreamId stream_id,
             dds::xrce::ACKNACK_Payload& acknack);
 
+    bool is_acknack_due(
+            dds::xrce::StreamId stream_id,
+            uint16_t max_received);
+
     void push_input_fragment(
             dds::xrce::StreamId stream_id,
             InputMessagePtr& message);
@@ -86,14 +107,29 @@ public:
             InputMessagePtr& message);
 
     /* Output streams functions. */
-    std::vector<uint8_t> get_output_streams();
 
+    /**
+     * @brief Calls a function with the id of every reliable output stream which may hold unacknowledged
+     *        messages, that is, streams with messages pushed since they were last fully acknowledged.
+     */
+    template<class F>
+    void for_each_unacked_stream(F f) const;
+
+    /**
+     * @brief Pushes a submessage into an output stream.
+     *        Aggregated submessages are kept in the open message of best-effort and reliable streams,
+     *        along with the following ones, until it is full or flushed.
+     */
     template<class T>
     bool push_output_submessage(
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            bool aggregate = false);
+
+    bool flush_output_stream(
+            dds::xrce::StreamId stream_id);
 
     bool get_next_output_message(
             dds::xrce::StreamId stream_id,
@@ -104,7 +140,7 @@ public:
             SeqNum seq_num,
             OutputMessagePtr& output_submessage);
 
-    void update_from_acknack(
+    bool update_from_acknack(
             dds::xrce::StreamId stream_id,
             SeqNum first_unacked);
 
@@ -112,58 +148,62 @@ public:
             dds::xrce::StreamId stream_id,
             dds::xrce::HEARTBEAT_Payload& heartbeat);
 
+    bool has_unacked_messages(
+            dds::xrce::StreamId stream_id);
+
+    /* ACKNACK and HEARTBEAT templates of the session. */
+    const ControlMessages& get_control_messages() const { return control_messages_; }
+
+    const StreamDepths& get_stream_depths() const { return depths_; }
+
 private:
-    ReliableOutputStream& get_reliable_output_stream(
+    void set_unacked(dds::xrce::StreamId stream_id)
+    {
+        unacked_streams_[(stream_id >> 6) & 1].fetch_or(uint64_t(1) << (stream_id & 63));
+    }
+
+    /* The stream is checked again once its bit is cleared, since a message may have been pushed meanwhile. */
+    void clear_unacked(
             dds::xrce::StreamId stream_id,
-            utils::SharedLock& shared_lock);
+            ReliableOutputStream& stream)
+    {
+        unacked_streams_[(stream_id >> 6) & 1].fetch_and(~(uint64_t(1) << (stream_id & 63)));
+        if (stream.has_unacked_messages())
+        {
+            set_unacked(stream_id);
+        }
+    }
 
 private:
     const SessionInfo session_info_;
+    const StreamDepths depths_;
+    const ControlMessages control_messages_;
 
+    /* Streams are created on first use, with the depths of the session. */
     NoneInputStream none_istream_;
-    std::unordered_map<dds::xrce::StreamId, BestEffortInputStream> best_effort_istreams_;
-    std::unordered_map<dds::xrce::StreamId, ReliableInputStream> reliable_istreams_;
-    std::mutex best_effort_imtx_;
-    std::mutex reliable_imtx_;
+    StreamTable<BestEffortInputStream> best_effort_istreams_;
+    StreamTable<ReliableInputStream> reliable_istreams_;
 
     NoneOutputStream none_ostream_;
-    std::unordered_map<dds::xrce::StreamId, BestEffortOutputStream> best_effort_ostreams_;
-    std::unordered_map<dds::xrce::StreamId, ReliableOutputStream> reliable_ostreams_;
-    std::mutex best_effort_omtx_;
-    utils::SharedMutex reliable_omtx_;
+    StreamTable<BestEffortOutputStream> best_effort_ostreams_;
+    StreamTable<ReliableOutputStream> reliable_ostreams_;
+
+    /* Reliable output streams with unacknowledged messages, one bit per stream. */
+    std::array<std::atomic<uint64_t>, 2> unacked_streams_;
 };
 
 inline void Session::reset()
 {
-    std::unique_lock<std::mutex> best_effort_ilock(best_effort_imtx_);
-    for (auto& it : best_effort_istreams_)
-    {
-        it.second.reset();
-    }
-    best_effort_ilock.unlock();
-
-    std::unique_lock<std::mutex> reliable_ilock(reliable_imtx_);
-    for (auto& it : reliable_istreams_)
-    {
-        it.second.reset();
-    }
-    reliable_ilock.unlock();
+    best_effort_istreams_.for_each([](uint8_t, BestEffortInputStream& stream) { stream.reset(); });
+    reliable_istreams_.for_each([](uint8_t, ReliableInputStream& stream) { stream.reset(); });
 
     none_ostream_.reset();
-
-    std::unique_lock<std::mutex> best_effort_olock(best_effort_omtx_);
-    for (auto& it : best_effort_ostreams_)
-    {
-        it.second.reset();
-    }
-    best_effort_olock.unlock();
-
-    utils::SharedLock reliable_olock(reliable_omtx_);
-    for (auto& it : reliable_ostreams_)
+    best_effort_ostreams_.for_each([](uint8_t, BestEffortOutputStream& stream) { stream.reset(); });
+    reliable_ostreams_.for_each([](uint8_t, ReliableOutputStream& stream) { stream.reset(); });
+    for (std::atomic<uint64_t>& word : unacked_streams_)
     {
-        it.second.reset();
+        word.store(0);
     }
-    reliable_olock.unlock();
 }
 
 /**************************************************************************************************
@@ -182,13 +222,11 @@ inline bool Session::push_input_message(
     }
     else if (is_besteffort_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(best_effort_imtx_);
-        rv = best_effort_istreams_[stream_id].push_message(sequence_nr, std::move(message));
+        rv = best_effort_istreams_.get(stream_id).push_message(sequence_nr, std::move(message));
     }
     else
     {
-        std::lock_guard<std::mutex> lock(reliable_imtx_);
-        rv = reliable_istreams_[stream_id].push_message(sequence_nr, std::move(message));
+        rv = reliable_istreams_.get(stream_id).push_message(sequence_nr, std::move(message));
     }
     return rv;
 }
@@ -204,13 +242,11 @@ inline bool Session::pop_input_message(
     }
     else if (is_besteffort_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(best_effort_imtx_);
-        rv = best_effort_istreams_[stream_id].pop_message(message);
+        rv = best_effort_istreams_.get(stream_id).pop_message(message);
     }
     else
     {
-        std::lock_guard<std::mutex> lock(reliable_imtx_);
-        rv = reliable_istreams_[stream_id].pop_message(message);
+        rv = reliable_istreams_.get(stream_id).pop_message(message);
     }
     return rv;
 }
@@ -222,8 +258,7 @@ inline void Session::update_from_heartbeat(
 {
     if (is_reliable_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].update_from_heartbeat(first_unacked, last_unacked);
+        reliable_istreams_.get(stream_id).update_from_heartbeat(first_unacked, last_unacked);
     }
 }
 
@@ -233,39 +268,58 @@ inline void Session::fill_acknack(
 {
     if (is_reliable_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].fill_acknack(acknack);
+        reliable_istreams_.get(stream_id).fill_acknack(acknack);
     }
 }
 
+inline bool Session::is_acknack_due(
+        dds::xrce::StreamId stream_id,
+        uint16_t max_received)
+{
+    bool rv = false;
+    if (is_reliable_stream(stream_id))
+    {
+        rv = reliable_istreams_.get(stream_id).is_acknack_due(max_received);
+    }
+    return rv;
+}
+
 inline void Session::push_input_fragment(dds::xrce::StreamId stream_id, InputMessagePtr& message)
 {
     if (is_reliable_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(reliable_imtx_);
-        reliable_istreams_[stream_id].push_fragment(message);
+        reliable_istreams_.get(stream_id).push_fragment(message);
     }
 }
 
 inline bool Session::pop_input_fragment_message(dds::xrce::StreamId stream_id, InputMessagePtr& message)
 {
-    std::lock_guard<std::mutex> lock(reliable_imtx_);
-    return reliable_istreams_[stream_id].pop_fragment_message(message);
+    bool rv = false;
+    if (is_reliable_stream(stream_id))
+    {
+        rv = reliable_istreams_.get(stream_id).pop_fragment_message(message);
+    }
+    return rv;
 }
 
 /**************************************************************************************************
  * Output Stream Methods.
  **************************************************************************************************/
 
-inline std::vector<uint8_t> Session::get_output_streams()
+template<class F>
+inline void Session::for_each_unacked_stream(F f) const
 {
-    utils::SharedLock lock(reliable_omtx_);
-    std::vector<uint8_t> result(reliable_ostreams_.size());
-    for (auto it = reliable_ostreams_.begin(); it != reliable_ostreams_.end(); ++it)
+    for (size_t i = 0; i < unacked_streams_.size(); ++i)
     {
-        result.push_back(it->first);
+        uint64_t word = unacked_streams_[i].load();
+        for (uint8_t bit = 0; 0 != word; ++bit, word >>= 1)
+        {
+            if (0 != (word & 1))
+            {
+                f(uint8_t(dds::xrce::STREAMID_BUILTIN_RELIABLE | (i << 6) | bit));
+            }
+        }
     }
-    return result;
 }
 
 template<class T>
@@ -273,7 +327,8 @@ inline bool Session::push_output_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        bool aggregate)
 {
     bool rv = false;
     if (is_none_stream(stream_id))
@@ -282,14 +337,36 @@ inline bool Session::push_output_submessage(
     }
     else if (is_besteffort_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].push_submessage(session_info_, stream_id, submessage_id, submessage);
+        rv = best_effort_ostreams_.get(stream_id).push_submessage(
+            session_info_, stream_id, submessage_id, submessage, aggregate);
     }
     else
     {
-        utils::SharedLock shared_lock(reliable_omtx_);
-        rv = get_reliable_output_stream(stream_id, shared_lock).push_submessage(
-            session_info_, stream_id, submessage_id, submessage, timeout);
+        rv = reliable_ostreams_.get(stream_id).push_submessage(
+            session_info_, stream_id, submessage_id, submessage, timeout, aggregate);
+        if (rv)
+        {
+            set_unacked(stream_id);
+        }
+    }
+    return rv;
+}
+
+inline bool Session::flush_output_stream(
+        dds::xrce::StreamId stream_id)
+{
+    bool rv = false;
+    if (is_besteffort_stream(stream_id))
+    {
+        rv = best_effort_ostreams_.get(stream_id).flush();
+    }
+    else if (is_reliable_stream(stream_id))
+    {
+        rv = reliable_ostreams_.get(stream_id).flush();
+        if (rv)
+        {
+            set_unacked(stream_id);
+        }
     }
     return rv;
 }
@@ -305,13 +382,11 @@ inline bool Session::get_next_output_message(
     }
     else if (is_besteffort_stream(stream_id))
     {
-        std::lock_guard<std::mutex> lock(best_effort_omtx_);
-        rv = best_effort_ostreams_[stream_id].pop_message(output_message);
+        rv = best_effort_ostreams_.get(stream_id).pop_message(output_message);
     }
     else
     {
-        utils::SharedLock shared_lock(reliable_omtx_);
-        rv = get_reliable_output_stream(stream_id, shared_lock).get_next_message(output_message);
+        rv = reliable_ostreams_.get(stream_id).get_next_message(output_message);
     }
     return rv;
 }
@@ -324,21 +399,26 @@ inline bool Session::get_output_message(
     bool rv = false;
     if (is_reliable_stream(stream_id))
     {
-        utils::SharedLock shared_lock(reliable_omtx_);
-        rv = get_reliable_output_stream(stream_id, shared_lock).get_message(seq_num, output_message);
+        rv = reliable_ostreams_.get(stream_id).get_message(seq_num, output_message);
     }
     return rv;
 }
 
-inline void Session::update_from_acknack(
+inline bool Session::update_from_acknack(
         const dds::xrce::StreamId stream_id,
         const SeqNum first_unacked)
 {
+    bool rv = false;
     if (is_reliable_stream(stream_id))
     {
-        utils::SharedLock shared_lock(reliable_omtx_);
-        get_reliable_output_stream(stream_id, shared_lock).update_from_acknack(first_unacked);
+        ReliableOutputStream& stream = reliable_ostreams_.get(stream_id);
+        rv = stream.update_from_acknack(first_unacked);
+        if (rv)
+        {
+            clear_unacked(stream_id, stream);
+        }
     }
+    return rv;
 }
 
 
@@ -349,30 +429,27 @@ inline bool Session::fill_heartbeat(
     bool rv = false;
     if (is_reliable_stream(stream_id))
     {
-        utils::SharedLock shared_lock(reliable_omtx_);
-        rv = get_reliable_output_stream(stream_id, shared_lock).fill_heartbeat(heartbeat);
+        ReliableOutputStream& stream = reliable_ostreams_.get(stream_id);
+        rv = stream.fill_heartbeat(heartbeat);
         heartbeat.stream_id(stream_id);
+        if (!rv)
+        {
+            clear_unacked(stream_id, stream);
+        }
     }
     return rv;
 }
 
-inline ReliableOutputStream& Session::get_reliable_output_stream(
-        dds::xrce::StreamId stream_id,
-        utils::SharedLock& shared_lock)
+inline bool Session::has_unacked_messages(
+        dds::xrce::StreamId stream_id)
 {
-    shared_lock.lock();
-    auto it = reliable_ostreams_.find(stream_id);
-    if (it != reliable_ostreams_.end())
-    {
-        return it->second;
-    }
-    else
+    bool rv = false;
+    if (is_reliable_stream(stream_id))
     {
-        shared_lock.unlock();
-        utils::ExclusiveLock exclusive_lock(reliable_omtx_);
-        shared_lock.lock();
-        return reliable_ostreams_[stream_id];
+        ReliableOutputStream* stream = reliable_ostreams_.find(stream_id);
+        rv = (nullptr != stream) && stream->has_unacked_messages();
     }
+    return rv;
 }
 
 } // namespace uxr
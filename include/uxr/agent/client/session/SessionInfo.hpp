@@ -15,6 +15,7 @@
 #ifndef UXR_AGENT_CLIENT_SESSION_SESSION_INFO_HPP_
 #define UXR_AGENT_CLIENT_SESSION_SESSION_INFO_HPP_
 
+#include <uxr/agent/config.hpp>
 #include <uxr/agent/types/XRCETypes.hpp>
 
 namespace eprosima {
@@ -27,6 +28,31 @@ struct SessionInfo
     size_t mtu;
 };
 
+/* Upper bound of the stream depths, which keeps reliable windows far below half the sequence number space. */
+const uint16_t MAX_STREAM_DEPTH = 4096;
+
+/* Default upper bound of the stream depths clients may ask for, the deepest of the default ones. */
+const uint16_t DEFAULT_MAX_CLIENT_STREAM_DEPTH = (RELIABLE_STREAM_DEPTH < BEST_EFFORT_STREAM_DEPTH)
+    ? BEST_EFFORT_STREAM_DEPTH
+    : RELIABLE_STREAM_DEPTH;
+
+/**
+ * Depth of the streams of a session, that is, the number of messages kept by each reliable window
+ * and queued by each none or best-effort stream.
+ */
+struct StreamDepths
+{
+    StreamDepths(
+            uint16_t reliable_depth = RELIABLE_STREAM_DEPTH,
+            uint16_t best_effort_depth = BEST_EFFORT_STREAM_DEPTH)
+        : reliable(reliable_depth)
+        , best_effort(best_effort_depth)
+    {}
+
+    uint16_t reliable;
+    uint16_t best_effort;
+};
+
 } // namespace uxr
 } // namespace eprosima
 
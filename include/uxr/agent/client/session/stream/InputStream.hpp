@@ -20,9 +20,11 @@
 #include <uxr/agent/utils/SeqNum.hpp>
 #include <uxr/agent/client/session/SessionInfo.hpp>
 
-#include <map>
+#include <algorithm>
+#include <array>
 #include <mutex>
 #include <queue>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -33,7 +35,9 @@ namespace uxr {
 class NoneInputStream
 {
 public:
-    NoneInputStream() = default;
+    explicit NoneInputStream(uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+    {}
 
     bool push_message(
             InputMessagePtr&& input_message);
@@ -48,6 +52,7 @@ public:
     void reset();
 
 private:
+    const uint16_t depth_;
     std::queue<InputMessagePtr> messages_;
     std::mutex mtx_;
 };
@@ -57,7 +62,7 @@ inline bool NoneInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (messages_.size() < BEST_EFFORT_STREAM_DEPTH)
+    if (messages_.size() < depth_)
     {
         messages_.push(std::move(input_message));
         rv = true;
@@ -71,7 +76,7 @@ inline bool NoneInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (messages_.size() < BEST_EFFORT_STREAM_DEPTH)
+    if (messages_.size() < depth_)
     {
         messages_.emplace(new InputMessage(std::forward<Args>(args)...));
         rv = true;
@@ -107,8 +112,9 @@ inline void NoneInputStream::reset()
 class BestEffortInputStream
 {
 public:
-    BestEffortInputStream()
-        : last_received_(UINT16_MAX)
+    explicit BestEffortInputStream(uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+        , last_received_(UINT16_MAX)
     {}
 
     ~BestEffortInputStream() = default;
@@ -132,6 +138,7 @@ public:
     void reset();
 
 private:
+    const uint16_t depth_;
     std::queue<InputMessagePtr> messages_;
     SeqNum last_received_;
     std::mutex mtx_;
@@ -143,7 +150,7 @@ inline bool BestEffortInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_received_) && (messages_.size() < BEST_EFFORT_STREAM_DEPTH))
+    if ((seq_num > last_received_) && (messages_.size() < depth_))
     {
         messages_.push(std::move(input_message));
         last_received_ = seq_num;
@@ -159,7 +166,7 @@ inline bool BestEffortInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_received_) && (messages_.size() < BEST_EFFORT_STREAM_DEPTH))
+    if ((seq_num > last_received_) && (messages_.size() < depth_))
     {
         messages_.emplace(new InputMessage(std::forward<Args>(args)...));
         last_received_ = seq_num;
@@ -197,9 +204,14 @@ inline void BestEffortInputStream::reset()
 class ReliableInputStream
 {
 public:
-    ReliableInputStream()
-        : last_handled_(UINT16_MAX),
+    explicit ReliableInputStream(uint16_t depth = RELIABLE_STREAM_DEPTH)
+        : depth_(depth),
+          last_handled_(UINT16_MAX),
           last_announced_(UINT16_MAX),
+          received_since_acknack_(0),
+          messages_(depth),
+          received_((depth + 63) / 64, 0),
+          head_(0),
           fragment_msg_{},
           fragment_message_available_(false)
     {}
@@ -228,6 +240,14 @@ public:
 
     void fill_acknack(dds::xrce::ACKNACK_Payload& acknack);
 
+    /**
+     * @brief Checks whether an ACKNACK shall be sent without further delay, that is, when the given number
+     *        of messages have been received since the last one or some message is known to be missing.
+     * @param max_received  The number of received messages acknowledged by a single ACKNACK.
+     * @return  true if the ACKNACK is due and false in other case.
+     */
+    bool is_acknack_due(uint16_t max_received);
+
     void push_fragment(InputMessagePtr& message);
 
     bool pop_fragment_message(InputMessagePtr& message);
@@ -235,9 +255,38 @@ public:
     void reset();
 
 private:
+    /* Window offset of a sequence number, being 0 the next one to be handled. */
+    uint16_t get_offset(SeqNum seq_num) const { return uint16_t(seq_num - (last_handled_ + 1)); }
+
+    size_t get_index(uint16_t offset) const { return (head_ + offset) % depth_; }
+
+    bool is_in_window(SeqNum seq_num) const
+    {
+        return (seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(depth_));
+    }
+
+    bool is_received(uint16_t offset) const
+    {
+        return 0 != (received_[offset >> 6] & (uint64_t(1) << (offset & 63)));
+    }
+
+    void store_message(
+            SeqNum seq_num,
+            InputMessagePtr&& message);
+
+    void advance(uint16_t count);
+
+private:
+    const uint16_t depth_;
     SeqNum last_handled_;
     SeqNum last_announced_;
-    std::map<uint16_t, InputMessagePtr> messages_;
+    uint16_t received_since_acknack_;
+
+    /* Ring of the window, starting at head_, along with a bitmap of the received messages
+       which keeps bit i for the sequence number last_handled_ + 1 + i. */
+    std::vector<InputMessagePtr> messages_;
+    std::vector<uint64_t> received_;
+    size_t head_;
     std::vector<uint8_t> fragment_msg_;
     bool fragment_message_available_;
     std::mutex mtx_;
@@ -249,23 +298,10 @@ inline bool ReliableInputStream::push_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(RELIABLE_STREAM_DEPTH)))
+    if (is_in_window(seq_num) && !is_received(get_offset(seq_num)))
     {
-        if (seq_num > last_announced_)
-        {
-            last_announced_ = seq_num;
-            messages_.emplace(seq_num, std::move(message));
-            rv = true;
-        }
-        else
-        {
-            auto it = messages_.find(seq_num);
-            if (it == messages_.end())
-            {
-                messages_.emplace(seq_num, std::move(message));
-                rv = true;
-            }
-        }
+        store_message(seq_num, std::move(message));
+        rv = true;
     }
     return rv;
 }
@@ -274,12 +310,10 @@ inline bool ReliableInputStream::pop_message(InputMessagePtr& message)
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    auto it = messages_.find(last_handled_ + 1);
-    if (it != messages_.end())
+    if (is_received(0))
     {
-        last_handled_ += 1;
-        message = std::move(messages_.at(last_handled_));
-        messages_.erase(last_handled_);
+        message = std::move(messages_[head_]);
+        advance(1);
         rv = true;
     }
     return rv;
@@ -292,28 +326,54 @@ inline bool ReliableInputStream::emplace_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if ((seq_num > last_handled_) && (seq_num <= last_handled_ + SeqNum(RELIABLE_STREAM_DEPTH)))
+    if (is_in_window(seq_num) && !is_received(get_offset(seq_num)))
     {
-        if (seq_num > last_announced_)
-        {
-            last_announced_ = seq_num;
-            // gcc5 doesn't not support raw pointer as argument in std::pair when std::unique_ptr is create.
-            messages_.emplace(seq_num,
-                              std::unique_ptr<InputMessage>(new InputMessage(std::forward<Args>(args)...)));
-            rv = true;
-        }
-        else
+        store_message(seq_num, InputMessagePtr(new InputMessage(std::forward<Args>(args)...)));
+        rv = true;
+    }
+    return rv;
+}
+
+inline void ReliableInputStream::store_message(
+        SeqNum seq_num,
+        InputMessagePtr&& message)
+{
+    const uint16_t offset = get_offset(seq_num);
+    messages_[get_index(offset)] = std::move(message);
+    received_[offset >> 6] |= uint64_t(1) << (offset & 63);
+    if (seq_num > last_announced_)
+    {
+        last_announced_ = seq_num;
+    }
+    ++received_since_acknack_;
+}
+
+inline void ReliableInputStream::advance(uint16_t count)
+{
+    /* Messages skipped by a HEARTBEAT are dropped, they will never be handled. */
+    for (uint16_t i = 0; (i < count) && (i < depth_); ++i)
+    {
+        messages_[get_index(i)].reset();
+    }
+    head_ = get_index(count % depth_);
+
+    /* Shift the bitmap, a single word unless the window is deeper than 64 messages. */
+    const size_t word_shift = count >> 6;
+    const size_t bit_shift = count & 63;
+    for (size_t i = 0; i < received_.size(); ++i)
+    {
+        uint64_t word = 0;
+        if (i + word_shift < received_.size())
         {
-            auto it = messages_.find(seq_num);
-            if (it == messages_.end())
+            word = received_[i + word_shift] >> bit_shift;
+            if ((0 != bit_shift) && (i + word_shift + 1 < received_.size()))
             {
-                messages_.emplace(seq_num,
-                                  std::unique_ptr<InputMessage>(new InputMessage(std::forward<Args>(args)...)));
-                rv = true;
+                word |= received_[i + word_shift + 1] << (64 - bit_shift);
             }
         }
+        received_[i] = word;
     }
-    return rv;
+    last_handled_ += count;
 }
 
 inline void ReliableInputStream::update_from_heartbeat(
@@ -323,7 +383,7 @@ inline void ReliableInputStream::update_from_heartbeat(
     std::lock_guard<std::mutex> lock(mtx_);
     if (last_handled_ + 1 < first_unacked)
     {
-        last_handled_ = first_unacked - 1;
+        advance(get_offset(first_unacked));
     }
     if (last_announced_ < last_unacked)
     {
@@ -333,28 +393,25 @@ inline void ReliableInputStream::update_from_heartbeat(
 
 inline void ReliableInputStream::fill_acknack(dds::xrce::ACKNACK_Payload& acknack)
 {
-    acknack.nack_bitmap() = {0, 0};
     std::lock_guard<std::mutex> lock(mtx_);
+    received_since_acknack_ = 0;
     acknack.first_unacked_seq_num(last_handled_ + 1);
-    for (uint16_t i = 0; i < 8; i++)
+
+    /* Announced messages not received yet, beyond the window when it is shorter than the bitmap. */
+    uint16_t missing = 0;
+    if (last_handled_ < last_announced_)
     {
-        if (last_handled_ + SeqNum(i) < last_announced_)
-        {
-            auto it = messages_.find(last_handled_ + SeqNum(i + 1));
-            if (it == messages_.end())
-            {
-                acknack.nack_bitmap().at(1) = acknack.nack_bitmap().at(1) | (0x01 << i);
-            }
-        }
-        if (last_handled_ + SeqNum(i + 8) < last_announced_)
-        {
-            auto it = messages_.find(last_handled_ + SeqNum(i + 9));
-            if (it == messages_.end())
-            {
-                acknack.nack_bitmap().at(0) = acknack.nack_bitmap().at(0) | (0x01 << i);
-            }
-        }
+        const uint32_t announced = std::min<uint32_t>(uint16_t(last_announced_ - last_handled_), 16);
+        const uint16_t received = uint16_t(received_[0] & 0xFFFF);
+        missing = uint16_t(((uint32_t(1) << announced) - 1) & ~uint32_t(received));
     }
+    acknack.nack_bitmap() = {uint8_t(missing >> 8), uint8_t(missing & 0xFF)};
+}
+
+inline bool ReliableInputStream::is_acknack_due(uint16_t max_received)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return (received_since_acknack_ >= max_received) || (last_handled_ < last_announced_);
 }
 
 inline void ReliableInputStream::reset()
@@ -362,7 +419,13 @@ inline void ReliableInputStream::reset()
     std::lock_guard<std::mutex> lock(mtx_);
     last_handled_ = UINT16_MAX;
     last_announced_ = UINT16_MAX;
-    messages_.clear();
+    received_since_acknack_ = 0;
+    for (InputMessagePtr& message : messages_)
+    {
+        message.reset();
+    }
+    std::fill(received_.begin(), received_.end(), 0);
+    head_ = 0;
 }
 
 inline void ReliableInputStream::push_fragment(InputMessagePtr& message)
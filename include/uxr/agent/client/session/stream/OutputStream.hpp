@@ -21,11 +21,12 @@
 #include <uxr/agent/client/session/SessionInfo.hpp>
 #include <uxr/agent/logger/Logger.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <queue>
 #include <mutex>
 #include <array>
-#include <map>
+#include <vector>
 #include <condition_variable>
 
 namespace eprosima {
@@ -37,7 +38,9 @@ namespace uxr {
 class NoneOutputStream
 {
 public:
-    NoneOutputStream() = default;
+    explicit NoneOutputStream(uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+    {}
 
     ~NoneOutputStream() = default;
 
@@ -57,6 +60,7 @@ public:
     bool pop_message(OutputMessagePtr& output_message);
 
 private:
+    const uint16_t depth_;
     std::queue<OutputMessagePtr> messages_;
     std::mutex mtx_;
 };
@@ -78,7 +82,7 @@ inline bool NoneOutputStream::push_submessage(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    if (BEST_EFFORT_STREAM_DEPTH > messages_.size())
+    if (depth_ > messages_.size())
     {
         /* Message header. */
         dds::xrce::MessageHeader message_header;
@@ -87,9 +91,13 @@ inline bool NoneOutputStream::push_submessage(
         message_header.sequence_nr(0x00);
         message_header.client_key(session_info.client_key);
 
-        /* Create message. */
-        OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
-        if (output_message->append_submessage(id, submessage))
+        /* Create message, sized to the submessage instead of the MTU. */
+        const size_t submessage_len = get_serialized_size(submessage);
+        const size_t message_size = std::min(
+            message_header.getCdrSerializedSize() + dds::xrce::SubmessageHeader().getCdrSerializedSize() + submessage_len,
+            size_t(session_info.mtu));
+        OutputMessagePtr output_message = OutputMessage::create(message_header, message_size);
+        if (output_message->append_sized_submessage(id, submessage, submessage_len))
         {
             /* Push message. */
             messages_.push(std::move(output_message));
@@ -118,8 +126,9 @@ inline bool NoneOutputStream::pop_message(OutputMessagePtr& output_message)
 class BestEffortOutputStream
 {
 public:
-    BestEffortOutputStream()
-        : last_sent_(UINT16_MAX)
+    explicit BestEffortOutputStream(uint16_t depth = BEST_EFFORT_STREAM_DEPTH)
+        : depth_(depth)
+        , last_sent_(UINT16_MAX)
     {}
 
     ~BestEffortOutputStream() = default;
@@ -133,17 +142,33 @@ public:
 //    void promote_stream() { last_sent_ += 1; }
     void reset();
 
+    /**
+     * @brief Appends a submessage to the open message, opening a new one when it does not fit.
+     * @param aggregate Whether the message is kept open for further submessages or closed at once.
+     */
     template<class T>
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
-            const T& submessage);
+            const T& submessage,
+            bool aggregate = false);
+
+    /**
+     * @brief Closes the open message, if any, so that it can be popped.
+     * @return  true if a message was closed and false in other case.
+     */
+    bool flush();
 
     bool pop_message(OutputMessagePtr& output_message);
 
 private:
+    void close_message();
+
+private:
+    const uint16_t depth_;
     std::queue<OutputMessagePtr> messages_;
+    OutputMessagePtr open_message_;
     SeqNum last_sent_;
     std::mutex mtx_;
 };
@@ -155,6 +180,7 @@ inline void BestEffortOutputStream::reset()
     {
         messages_.pop();
     }
+    open_message_.reset();
     last_sent_ = UINT16_MAX;
 }
 
@@ -163,41 +189,87 @@ inline bool BestEffortOutputStream::push_submessage(
         const SessionInfo& session_info,
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
-        const T& submessage)
+        const T& submessage,
+        bool aggregate)
 {
     bool rv = false;
+    const size_t submessage_len = get_serialized_size(submessage);
     std::lock_guard<std::mutex> lock(mtx_);
-    if (BEST_EFFORT_STREAM_DEPTH > messages_.size())
+    if (open_message_ && !open_message_->fits_submessage(submessage_len))
     {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(stream_id);
-        message_header.sequence_nr(last_sent_ + 1);
-        message_header.client_key(session_info.client_key);
+        close_message();
+    }
 
-        /* Create message. */
-        OutputMessagePtr output_message(new OutputMessage(message_header, session_info.mtu));
-        if (session_info.mtu < submessage.getCdrSerializedSize())
+    if (open_message_ || (depth_ > messages_.size()))
+    {
+        if (session_info.mtu < submessage_len)
         {
             UXR_AGENT_LOG_WARN(
                 UXR_DECORATE_YELLOW("serialization warning"),
                 "Trying to serialize {:d} in {:d} MTU stream",
-                submessage.getCdrSerializedSize(),
+                submessage_len,
                 session_info.mtu);
             rv = true;
         }
-        else if (output_message->append_submessage(submessage_id, submessage))
+        else
         {
-            /* Push message. */
-            messages_.push(std::move(output_message));
-            last_sent_ += 1;
-            rv = true;
+            const bool opened = !open_message_;
+            if (opened)
+            {
+                /* Message header. */
+                dds::xrce::MessageHeader message_header;
+                message_header.session_id(session_info.session_id);
+                message_header.stream_id(stream_id);
+                message_header.sequence_nr(last_sent_ + 1);
+                message_header.client_key(session_info.client_key);
+
+                /* Create message, with room for further submessages only if it is aggregated. */
+                const size_t message_size = aggregate
+                    ? size_t(session_info.mtu)
+                    : std::min(
+                        message_header.getCdrSerializedSize() + dds::xrce::SubmessageHeader().getCdrSerializedSize() + submessage_len,
+                        size_t(session_info.mtu));
+                open_message_ = OutputMessage::create(message_header, message_size);
+            }
+
+            if (open_message_->append_sized_submessage(submessage_id, submessage, submessage_len))
+            {
+                rv = true;
+            }
+            else if (opened)
+            {
+                open_message_.reset();
+            }
         }
     }
+
+    if (!aggregate && open_message_)
+    {
+        close_message();
+    }
+    return rv;
+}
+
+inline bool BestEffortOutputStream::flush()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (open_message_)
+    {
+        close_message();
+        rv = true;
+    }
     return rv;
 }
 
+inline void BestEffortOutputStream::close_message()
+{
+    /* Push message. */
+    messages_.push(std::move(open_message_));
+    open_message_.reset();
+    last_sent_ += 1;
+}
+
 inline bool BestEffortOutputStream::pop_message(OutputMessagePtr& output_message)
 {
     std::lock_guard<std::mutex> lock(mtx_);
@@ -217,8 +289,10 @@ inline bool BestEffortOutputStream::pop_message(OutputMessagePtr& output_message
 class ReliableOutputStream
 {
 public:
-    ReliableOutputStream()
-        : last_unacked_(UINT16_MAX)
+    explicit ReliableOutputStream(uint16_t depth = RELIABLE_STREAM_DEPTH)
+        : depth_(depth)
+        , messages_(get_ring_size(depth))
+        , last_unacked_(UINT16_MAX)
         , last_sent_(UINT16_MAX)
         , first_unacked_(0x0000)
     {}
@@ -227,13 +301,25 @@ public:
 
     void reset();
 
+    /**
+     * @brief Appends a submessage to the open message, opening a new one when it does not fit.
+     *        Submessages larger than the MTU are fragmented in messages of their own.
+     * @param aggregate Whether the message is kept open for further submessages or closed at once.
+     */
     template<class T>
     bool push_submessage(
             const SessionInfo& session_info,
             dds::xrce::StreamId stream_id,
             dds::xrce::SubmessageId submessage_id,
             const T& submessage,
-            std::chrono::milliseconds timeout);
+            std::chrono::milliseconds timeout,
+            bool aggregate = false);
+
+    /**
+     * @brief Closes the open message, if any, which takes the next sequence number.
+     * @return  true if a message was closed and false in other case.
+     */
+    bool flush();
 
     bool get_next_message(OutputMessagePtr& output_message);
 
@@ -241,12 +327,41 @@ public:
             SeqNum seq_num,
             OutputMessagePtr& output_message);
 
-    void update_from_acknack(SeqNum first_unacked);
+    bool update_from_acknack(SeqNum first_unacked);
 
     bool fill_heartbeat(dds::xrce::HEARTBEAT_Payload& heartbeat);
 
+    bool has_unacked_messages();
+
+private:
+    void close_message();
+
+    /* The window is always contiguous, from first_unacked_ to last_unacked_. */
+    bool is_empty() const { return last_unacked_ + 1 == first_unacked_; }
+
+    OutputMessagePtr& get_slot(SeqNum seq_num) { return messages_[uint16_t(seq_num) & (messages_.size() - 1)]; }
+
+    void store_message(
+            SeqNum seq_num,
+            OutputMessagePtr&& output_message);
+
+    /* Smallest power of two holding the window, so that slots stay consistent when sequence numbers wrap. */
+    static size_t get_ring_size(uint16_t depth)
+    {
+        size_t size = 1;
+        while (size < depth)
+        {
+            size <<= 1;
+        }
+        return size;
+    }
+
 private:
-    std::map<uint16_t, OutputMessagePtr> messages_;
+    const uint16_t depth_;
+
+    /* Ring indexed by sequence number. It only grows when a fragmented submessage exceeds the window. */
+    std::vector<OutputMessagePtr> messages_;
+    OutputMessagePtr open_message_;
     SeqNum last_unacked_;
     SeqNum last_sent_;
     SeqNum first_unacked_;
@@ -273,7 +388,11 @@ inline void ReliableOutputStream::reset()
     last_unacked_ = UINT16_MAX;
     last_sent_ = UINT16_MAX;
     first_unacked_ = 0x0000;
-    messages_.clear();
+    for (OutputMessagePtr& output_message : messages_)
+    {
+        output_message.reset();
+    }
+    open_message_.reset();
 }
 
 template<class T>
@@ -282,99 +401,164 @@ inline bool ReliableOutputStream::push_submessage(
         dds::xrce::StreamId stream_id,
         dds::xrce::SubmessageId submessage_id,
         const T& submessage,
-        std::chrono::milliseconds timeout)
+        std::chrono::milliseconds timeout,
+        bool aggregate)
 {
     bool rv = false;
+    const size_t submessage_len = get_serialized_size(submessage);
     std::unique_lock<std::mutex> lock(mtx_);
-    auto now = std::chrono::steady_clock::now();
-
-    if (cv_.wait_until(
-            lock,
-            now + timeout, [&](){ return last_unacked_ < first_unacked_ + SeqNum(RELIABLE_STREAM_DEPTH - 1); }))
+    if (open_message_ && open_message_->fits_submessage(submessage_len))
     {
-        /* Message header. */
-        dds::xrce::MessageHeader message_header;
-        message_header.session_id(session_info.session_id);
-        message_header.stream_id(stream_id);
-        message_header.client_key(session_info.client_key);
-
-        /* Submessage header. */
-        dds::xrce::SubmessageHeader submessage_header;
-        submessage_header.submessage_id(submessage_id);
-        submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-        submessage_header.submessage_length(uint16_t(submessage.getCdrSerializedSize()));
-
-        /* Compute message size. */
-        const size_t header_size = message_header.getCdrSerializedSize();
-        const size_t subheader_size = submessage_header.getCdrSerializedSize();
-        const size_t submessage_size = subheader_size + submessage.getCdrSerializedSize();
+        rv = open_message_->append_sized_submessage(submessage_id, submessage, submessage_len);
+    }
+    else
+    {
+        if (open_message_)
+        {
+            close_message();
+        }
 
-        /* Push submessage. */
-        if ((header_size + submessage_size) <= session_info.mtu)
+        /* The open message already holds a slot of the window, which it takes when closed. */
+        auto now = std::chrono::steady_clock::now();
+        if (cv_.wait_until(
+                lock,
+                now + timeout, [&](){ return last_unacked_ + SeqNum(open_message_ ? 1 : 0)
+                    < first_unacked_ + SeqNum(depth_ - 1); }))
         {
-            /* Create message. */
-            last_unacked_ += 1;
-            message_header.sequence_nr(last_unacked_);
-            OutputMessagePtr output_message(new OutputMessage(message_header, header_size + submessage_size));
-            if (output_message->append_submessage(submessage_id, submessage))
+            if (open_message_)
             {
-                /* Push message. */
-                messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
-                rv = true;
+                /* Opened by another push while waiting. */
+                close_message();
             }
-        }
-        else
-        {
-            /* Serialize submessage. */
-            std::unique_ptr<uint8_t[]> buf(new uint8_t[submessage_size]);
-            fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), submessage_size);
-            fastcdr::Cdr serializer(fastbuffer);
-            submessage_header.serialize(serializer);
-            submessage.serialize(serializer);
-
-            const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
-            dds::xrce::SubmessageHeader fragment_subheader;
-            fragment_subheader.submessage_id(dds::xrce::FRAGMENT);
-            fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-            fragment_subheader.submessage_length(uint16_t(max_fragment_size));
-
-            uint16_t serialized_size = 0;
-            do
+
+            /* Message header. */
+            dds::xrce::MessageHeader message_header;
+            message_header.session_id(session_info.session_id);
+            message_header.stream_id(stream_id);
+            message_header.client_key(session_info.client_key);
+
+            /* Submessage header. */
+            dds::xrce::SubmessageHeader submessage_header;
+            submessage_header.submessage_id(submessage_id);
+            submessage_header.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+            submessage_header.submessage_length(uint16_t(submessage_len));
+
+            /* Compute message size. */
+            const size_t header_size = message_header.getCdrSerializedSize();
+            const size_t subheader_size = submessage_header.getCdrSerializedSize();
+            const size_t submessage_size = subheader_size + submessage_len;
+
+            /* Push submessage. */
+            if ((header_size + submessage_size) <= session_info.mtu)
             {
-                uint16_t fragment_size;
-                if (session_info.mtu < (header_size + subheader_size + (submessage_size - serialized_size)))
+                /* Create message, with room for further submessages if it is aggregated. */
+                message_header.sequence_nr(last_unacked_ + 1);
+                open_message_ = OutputMessage::create(
+                    message_header, aggregate ? session_info.mtu : header_size + submessage_size);
+                if (open_message_->append_sized_submessage(submessage_id, submessage, submessage_len))
                 {
-                    fragment_size = uint16_t(max_fragment_size);
+                    rv = true;
                 }
                 else
                 {
-                    fragment_size = uint16_t(submessage_size - serialized_size);
-                    fragment_subheader.flags(submessage_header.flags() | dds::xrce::FLAG_LAST_FRAGMENT);
+                    open_message_.reset();
                 }
-                fragment_subheader.submessage_length(fragment_size);
+            }
+            else
+            {
+                /* Serialize submessage. */
+                std::unique_ptr<uint8_t[]> buf(new uint8_t[submessage_size]);
+                fastcdr::FastBuffer fastbuffer(reinterpret_cast<char*>(buf.get()), submessage_size);
+                fastcdr::Cdr serializer(fastbuffer);
+                submessage_header.serialize(serializer);
+                submessage.serialize(serializer);
+
+                const size_t max_fragment_size = session_info.mtu - header_size - subheader_size;
+                dds::xrce::SubmessageHeader fragment_subheader;
+                fragment_subheader.submessage_id(dds::xrce::FRAGMENT);
+                fragment_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
+                fragment_subheader.submessage_length(uint16_t(max_fragment_size));
+
+                uint16_t serialized_size = 0;
+                do
+                {
+                    uint16_t fragment_size;
+                    if (session_info.mtu < (header_size + subheader_size + (submessage_size - serialized_size)))
+                    {
+                        fragment_size = uint16_t(max_fragment_size);
+                    }
+                    else
+                    {
+                        fragment_size = uint16_t(submessage_size - serialized_size);
+                        fragment_subheader.flags(submessage_header.flags() | dds::xrce::FLAG_LAST_FRAGMENT);
+                    }
+                    fragment_subheader.submessage_length(fragment_size);
+
+                    const size_t current_message_size = header_size + subheader_size + fragment_size;
+
+                    /* Create message. */
+                    last_unacked_ += 1;
+                    message_header.sequence_nr(last_unacked_);
+                    OutputMessagePtr output_message = OutputMessage::create(message_header, current_message_size);
+                    if (output_message->append_fragment(fragment_subheader,  buf.get() + serialized_size, fragment_size))
+                    {
+                        /* Push message. */
+                        store_message(last_unacked_, std::move(output_message));
+                        serialized_size += fragment_size;
+                    }
+                    else
+                    {
+                        break;
+                    }
+
+                } while (serialized_size < submessage_size);
+                rv = (serialized_size == submessage_size);
+            }
+        }
+    }
+
+    if (!aggregate && open_message_)
+    {
+        close_message();
+    }
+    return rv;
+}
 
-                const size_t current_message_size = header_size + subheader_size + fragment_size;
+inline bool ReliableOutputStream::flush()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (open_message_)
+    {
+        close_message();
+        rv = true;
+    }
+    return rv;
+}
 
-                /* Create message. */
-                last_unacked_ += 1;
-                message_header.sequence_nr(last_unacked_);
-                OutputMessagePtr output_message(new OutputMessage(message_header, current_message_size));
-                if (output_message->append_fragment(fragment_subheader,  buf.get() + serialized_size, fragment_size))
-                {
-                    /* Push message. */
-                    messages_.insert(std::make_pair(last_unacked_, std::move(output_message)));
-                    serialized_size += fragment_size;
-                }
-                else
-                {
-                    break;
-                }
+inline void ReliableOutputStream::close_message()
+{
+    /* Push message. */
+    last_unacked_ += 1;
+    store_message(last_unacked_, std::move(open_message_));
+    open_message_.reset();
+}
 
-            } while (serialized_size < submessage_size);
-            rv = (serialized_size == submessage_size);
+inline void ReliableOutputStream::store_message(
+        SeqNum seq_num,
+        OutputMessagePtr&& output_message)
+{
+    const uint16_t count = uint16_t(seq_num - first_unacked_);
+    if (count >= messages_.size())
+    {
+        std::vector<OutputMessagePtr> messages(messages_.size() * 2);
+        for (SeqNum it = first_unacked_; it != seq_num; ++it)
+        {
+            messages[uint16_t(it) & (messages.size() - 1)] = std::move(get_slot(it));
         }
+        messages_.swap(messages);
     }
-    return rv;
+    get_slot(seq_num) = std::move(output_message);
 }
 
 inline bool ReliableOutputStream::get_next_message(OutputMessagePtr& output_message)
@@ -384,7 +568,7 @@ inline bool ReliableOutputStream::get_next_message(OutputMessagePtr& output_mess
     if (last_sent_ < last_unacked_)
     {
         last_sent_ += 1;
-        output_message = messages_.at(last_sent_);
+        output_message = get_slot(last_sent_);
         rv = true;
     }
     return rv;
@@ -396,27 +580,27 @@ inline bool ReliableOutputStream::get_message(
 {
     bool rv = false;
     std::lock_guard<std::mutex> lock(mtx_);
-    auto it = messages_.find(seq_num);
-    if (it != messages_.end())
+    if ((first_unacked_ <= seq_num) && (seq_num <= last_unacked_))
     {
-        output_message = it->second;
+        output_message = get_slot(seq_num);
         rv = true;
     }
     return rv;
 }
 
-inline void ReliableOutputStream::update_from_acknack(SeqNum first_unacked)
+inline bool ReliableOutputStream::update_from_acknack(SeqNum first_unacked)
 {
     std::lock_guard<std::mutex> lock(mtx_);
     if (first_unacked <= last_sent_ + 1)
     {
         while (first_unacked > first_unacked_)
         {
-            messages_.erase(first_unacked_);
+            get_slot(first_unacked_).reset();
             first_unacked_ += 1;
         }
         cv_.notify_one();
     }
+    return is_empty();
 }
 
 inline bool ReliableOutputStream::fill_heartbeat(dds::xrce::HEARTBEAT_Payload& heartbeat)
@@ -424,7 +608,13 @@ inline bool ReliableOutputStream::fill_heartbeat(dds::xrce::HEARTBEAT_Payload& h
     std::lock_guard<std::mutex> lock(mtx_);
     heartbeat.first_unacked_seq_nr(first_unacked_);
     heartbeat.last_unacked_seq_nr(last_unacked_);
-    return !messages_.empty();
+    return !is_empty();
+}
+
+inline bool ReliableOutputStream::has_unacked_messages()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    return !is_empty();
 }
 
 } // namespace uxr
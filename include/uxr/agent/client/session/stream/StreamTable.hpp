@@ -0,0 +1,128 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_CLIENT_SESSION_STREAM_STREAM_TABLE_HPP_
+#define UXR_AGENT_CLIENT_SESSION_STREAM_STREAM_TABLE_HPP_
+
+#include <uxr/agent/types/XRCETypes.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Streams of a kind within a session, indexed by the low 7 bits of their id
+ * (best-effort ids span 1 to 127 and reliable ones 128 to 255).
+ * Streams are created on first use and live as long as the table. Lookups are lock-free,
+ * and only the creation of a stream takes the table lock; every stream does its own locking.
+ */
+template<class Stream>
+class StreamTable
+{
+public:
+    static constexpr size_t SIZE = 128;
+
+    explicit StreamTable(uint16_t depth)
+        : depth_(depth)
+        , slots_()
+        , mtx_()
+    {
+        for (std::atomic<Stream*>& slot : slots_)
+        {
+            slot.store(nullptr, std::memory_order_relaxed);
+        }
+    }
+
+    ~StreamTable()
+    {
+        for (std::atomic<Stream*>& slot : slots_)
+        {
+            delete slot.load(std::memory_order_relaxed);
+        }
+    }
+
+    StreamTable(StreamTable&&) = delete;
+    StreamTable(const StreamTable&) = delete;
+    StreamTable& operator=(StreamTable&&) = delete;
+    StreamTable& operator=(const StreamTable&) = delete;
+
+    /**
+     * @brief Gets a stream, creating it if it does not exist yet.
+     * @param stream_id The id of the stream.
+     * @return  The stream.
+     */
+    Stream& get(dds::xrce::StreamId stream_id)
+    {
+        const size_t index = get_index(stream_id);
+        Stream* stream = slots_[index].load(std::memory_order_acquire);
+        if (nullptr == stream)
+        {
+            std::lock_guard<std::mutex> lock(mtx_);
+            stream = slots_[index].load(std::memory_order_relaxed);
+            if (nullptr == stream)
+            {
+                stream = new Stream(depth_);
+                slots_[index].store(stream, std::memory_order_release);
+            }
+        }
+        return *stream;
+    }
+
+    /**
+     * @brief Gets a stream only if it already exists.
+     * @param stream_id The id of the stream.
+     * @return  The stream or nullptr.
+     */
+    Stream* find(dds::xrce::StreamId stream_id) const
+    {
+        return slots_[get_index(stream_id)].load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Calls a function with the low 7 bits of the id of every existing stream, along with the stream.
+     */
+    template<class F>
+    void for_each(F f)
+    {
+        for (size_t i = 0; i < SIZE; ++i)
+        {
+            Stream* stream = slots_[i].load(std::memory_order_acquire);
+            if (nullptr != stream)
+            {
+                f(uint8_t(i), *stream);
+            }
+        }
+    }
+
+private:
+    static size_t get_index(dds::xrce::StreamId stream_id) { return stream_id & (SIZE - 1); }
+
+private:
+    const uint16_t depth_;
+    /* Slots own their streams, which are deleted along with the table. */
+    std::array<std::atomic<Stream*>, SIZE> slots_;
+    std::mutex mtx_;
+};
+
+template<class Stream>
+constexpr size_t StreamTable<Stream>::SIZE;
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_CLIENT_SESSION_STREAM_STREAM_TABLE_HPP_
@@ -0,0 +1,138 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_MESSAGE_CONTROL_MESSAGES_HPP_
+#define UXR_AGENT_MESSAGE_CONTROL_MESSAGES_HPP_
+
+#include <uxr/agent/client/session/SessionInfo.hpp>
+#include <uxr/agent/message/OutputMessage.hpp>
+#include <uxr/agent/types/XRCETypes.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Pre-serialized ACKNACK and HEARTBEAT messages of a session.
+ * Both are fixed-size and only differ in the payload fields, so a message is built by copying
+ * its template and patching those fields in place, instead of running the serializer.
+ */
+class ControlMessages
+{
+public:
+    ControlMessages(
+            const SessionInfo& session_info)
+        : mtu_(session_info.mtu)
+        , acknack_{}
+        , heartbeat_{}
+    {
+        dds::xrce::MessageHeader header;
+        header.session_id(session_info.session_id);
+        header.stream_id(dds::xrce::STREAMID_NONE);
+        header.sequence_nr(0x00);
+        header.client_key(session_info.client_key);
+
+        build(header, dds::xrce::ACKNACK, dds::xrce::ACKNACK_Payload{}, acknack_);
+        build(header, dds::xrce::HEARTBEAT, dds::xrce::HEARTBEAT_Payload{}, heartbeat_);
+    }
+
+    std::shared_ptr<OutputMessage> create_acknack(
+            const dds::xrce::ACKNACK_Payload& acknack) const
+    {
+        const uint16_t first_unacked = acknack.first_unacked_seq_num();
+        std::shared_ptr<OutputMessage> message = OutputMessage::create(acknack_.data, acknack_.len, acknack_.len);
+        uint8_t* payload = message->get_buf() + acknack_.payload_offset;
+        memcpy(payload, &first_unacked, sizeof(first_unacked));
+        memcpy(payload + 2, acknack.nack_bitmap().data(), acknack.nack_bitmap().size());
+        payload[4] = acknack.stream_id();
+        return message;
+    }
+
+    /**
+     * @brief Packs HEARTBEAT submessages into a single message, as many as fit in the session MTU
+     *        (at least one).
+     * @param heartbeats    The HEARTBEAT payloads.
+     * @param index         The first payload to pack, advanced past the packed ones.
+     * @return  The message.
+     */
+    std::shared_ptr<OutputMessage> create_heartbeats(
+            const std::vector<dds::xrce::HEARTBEAT_Payload>& heartbeats,
+            size_t& index) const
+    {
+        const size_t submessage_len = heartbeat_.len - heartbeat_.header_len;
+        const size_t stride = (submessage_len + 3) & ~size_t(3);
+        const size_t max_count = (heartbeat_.len < mtu_) ? 1 + (mtu_ - heartbeat_.len) / stride : 1;
+        const size_t count = std::min(heartbeats.size() - index, max_count);
+
+        std::shared_ptr<OutputMessage> message = OutputMessage::create(
+            heartbeat_.data, heartbeat_.header_len, heartbeat_.len + (count - 1) * stride);
+        for (size_t i = index; i < index + count; ++i)
+        {
+            const uint16_t first_unacked = heartbeats[i].first_unacked_seq_nr();
+            const uint16_t last_unacked = heartbeats[i].last_unacked_seq_nr();
+            uint8_t* payload = message->append_serialized(heartbeat_.data + heartbeat_.header_len, submessage_len)
+                + (heartbeat_.payload_offset - heartbeat_.header_len);
+            memcpy(payload, &first_unacked, sizeof(first_unacked));
+            memcpy(payload + 2, &last_unacked, sizeof(last_unacked));
+            payload[4] = heartbeats[i].stream_id();
+        }
+        index += count;
+        return message;
+    }
+
+private:
+    /* Header (up to 8 bytes), subheader (4 bytes) and payload (5 bytes). */
+    static constexpr size_t MAX_LEN = 17;
+
+    struct Template
+    {
+        uint8_t data[MAX_LEN];
+        size_t len;
+        size_t header_len;
+        size_t payload_offset;
+    };
+
+    /*
+     * Both payloads start 4-byte aligned, so their 16-bit fields need no padding: they lie at
+     * offsets 0 and 2, in the native byte order as the serializer writes them, and the stream id at 4.
+     */
+    template<class T>
+    static void build(
+            const dds::xrce::MessageHeader& header,
+            dds::xrce::SubmessageId submessage_id,
+            const T& payload,
+            Template& output)
+    {
+        OutputMessage message(header, MAX_LEN);
+        message.append_submessage(submessage_id, payload);
+        output.len = message.get_len();
+        output.header_len = header.getCdrSerializedSize();
+        output.payload_offset = output.len - payload.getCdrSerializedSize();
+        memcpy(output.data, message.get_buf(), output.len);
+    }
+
+private:
+    const size_t mtu_;
+    Template acknack_;
+    Template heartbeat_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_MESSAGE_CONTROL_MESSAGES_HPP_
@@ -0,0 +1,70 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_MESSAGE_DATA_PAYLOAD_VIEW_HPP_
+#define UXR_AGENT_MESSAGE_DATA_PAYLOAD_VIEW_HPP_
+
+#include <uxr/agent/types/XRCETypes.hpp>
+
+#include <fastcdr/Cdr.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * DATA submessage payload in FORMAT_DATA which references the sample instead of owning it.
+ * It serializes as a dds::xrce::DATA_Payload_Data, so the sample is copied once, straight
+ * from the reader buffer into the output message (or the fragmentation buffer).
+ */
+class DataPayloadView
+{
+public:
+    DataPayloadView(
+            const dds::xrce::RequestId& request_id,
+            const dds::xrce::ObjectId& object_id,
+            const uint8_t* data,
+            size_t size)
+        : request_id_(request_id)
+        , object_id_(object_id)
+        , data_(data)
+        , size_(size)
+    {}
+
+    size_t getCdrSerializedSize(size_t current_alignment = 0) const
+    {
+        (void) current_alignment;
+        return request_id_.size() + object_id_.size() + size_;
+    }
+
+    void serialize(fastcdr::Cdr& scdr) const
+    {
+        scdr.serializeArray(request_id_.data(), request_id_.size());
+        scdr.serializeArray(object_id_.data(), object_id_.size());
+        scdr.serializeArray(data_, size_);
+    }
+
+private:
+    const dds::xrce::RequestId& request_id_;
+    const dds::xrce::ObjectId& object_id_;
+    const uint8_t* data_;
+    size_t size_;
+};
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_MESSAGE_DATA_PAYLOAD_VIEW_HPP_
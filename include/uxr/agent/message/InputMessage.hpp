@@ -15,8 +15,10 @@
 #ifndef UXR_AGENT_MESSAGE_INPUT_MESSAGE_HPP_
 #define UXR_AGENT_MESSAGE_INPUT_MESSAGE_HPP_
 
+#include <uxr/agent/config.hpp>
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
+#include <uxr/agent/utils/BufferPool.hpp>
 
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
@@ -27,10 +29,14 @@ namespace uxr {
 class InputMessage
 {
 public:
+    /**
+     * @brief Copies the message, into a buffer of the pool if it fits.
+     */
     InputMessage(
             uint8_t* buf,
             size_t len)
-        : buf_(new uint8_t[len]),
+        : buffer_((len <= INPUT_BUFFER_SIZE) ? get_buffer_pool().acquire() : utils::PooledBuffer()),
+          buf_(buffer_ ? buffer_.data() : new uint8_t[len]),
           len_(len),
           header_(),
           subheader_(),
@@ -41,13 +47,46 @@ public:
         deserialize(header_);
     }
 
+    /**
+     * @brief Takes the buffer the message was received into, without copying it.
+     * @param buffer    A buffer of the pool.
+     * @param len       The length of the message.
+     */
+    InputMessage(
+            utils::PooledBuffer&& buffer,
+            size_t len)
+        : buffer_(std::move(buffer)),
+          buf_(buffer_.data()),
+          len_(len),
+          header_(),
+          subheader_(),
+          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          deserializer_(fastbuffer_)
+    {
+        deserialize(header_);
+    }
+
     uint8_t* get_buf() const { return buf_; }
 
     size_t get_len() const { return len_; }
 
     ~InputMessage()
     {
-        delete[] buf_;
+        if (!buffer_)
+        {
+            delete[] buf_;
+        }
+    }
+
+    /**
+     * @brief Returns the process-wide pool of INPUT_BUFFER_SIZE buffers which the transports
+     *        receive into, shared by all the agents.
+     */
+    static utils::BufferPool& get_buffer_pool()
+    {
+        /* Never destroyed, so that it outlives every message. */
+        static utils::BufferPool* pool = new utils::BufferPool(INPUT_BUFFER_SIZE, INPUT_BUFFER_POOL_FREE_MAX);
+        return *pool;
     }
 
     InputMessage(InputMessage&&) = delete;
@@ -66,6 +105,15 @@ public:
 
     bool get_raw_payload(uint8_t* buf, size_t len);
 
+    /**
+     * @brief Points to the next bytes of the message, without copying them.
+     *        The view is valid as long as the message.
+     * @param buf   The view.
+     * @param len   The number of bytes.
+     * @return  true in case of success and false if the message is shorter.
+     */
+    bool get_raw_payload_view(const uint8_t*& buf, size_t len);
+
     bool prepare_next_submessage();
 
 private:
@@ -75,6 +123,9 @@ private:
     void log_error();
 
 private:
+    static constexpr size_t INPUT_BUFFER_POOL_FREE_MAX = 1024;
+
+    utils::PooledBuffer buffer_;
     uint8_t* buf_;
     size_t len_;
     dds::xrce::MessageHeader header_;
@@ -135,6 +186,19 @@ inline bool InputMessage::get_raw_payload(uint8_t* buf, size_t len)
     return rv;
 }
 
+inline bool InputMessage::get_raw_payload_view(const uint8_t*& buf, size_t len)
+{
+    bool rv = false;
+    const size_t position = deserializer_.getSerializedDataLength();
+    if (len <= len_ - position)
+    {
+        buf = buf_ + position;
+        deserializer_.jump(len);
+        rv = true;
+    }
+    return rv;
+}
+
 template<class T>
 inline bool InputMessage::deserialize(T& data)
 {
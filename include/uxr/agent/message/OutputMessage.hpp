@@ -17,11 +17,19 @@
 
 #include <uxr/agent/types/MessageHeader.hpp>
 #include <uxr/agent/types/SubMessageHeader.hpp>
+#include <uxr/agent/types/SerializedSize.hpp>
 #include <uxr/agent/utils/Functions.hpp>
+#include <uxr/agent/utils/BufferPool.hpp>
+#include <uxr/agent/utils/PoolAllocator.hpp>
 
 #include <fastcdr/Cdr.h>
 #include <fastcdr/exceptions/Exception.h>
 
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <memory>
+
 namespace eprosima {
 namespace uxr {
 
@@ -31,7 +39,8 @@ public:
     OutputMessage(
             const dds::xrce::MessageHeader& header,
             size_t len)
-        : buf_(new uint8_t[len]{0}),
+        : buffer_(acquire_buffer(len)),
+          buf_(buffer_ ? buffer_.data() : allocate_unpooled(len)),
           len_(len),
           fastbuffer_(reinterpret_cast<char*>(buf_), len_),
           serializer_(fastbuffer_)
@@ -39,11 +48,81 @@ public:
         serialize(header);
     }
 
+    /**
+     * @brief Copies an already serialized message, to which further submessages may be appended.
+     * @param buf       The serialized message.
+     * @param len       The length of the serialized message.
+     * @param max_len   The maximum length of the message.
+     */
+    OutputMessage(
+            const uint8_t* buf,
+            size_t len,
+            size_t max_len)
+        : buffer_(acquire_buffer(max_len)),
+          buf_(buffer_ ? buffer_.data() : allocate_unpooled(max_len)),
+          len_(max_len),
+          fastbuffer_(reinterpret_cast<char*>(buf_), len_),
+          serializer_(fastbuffer_)
+    {
+        memcpy(buf_, buf, len);
+        serializer_.jump(len);
+    }
+
     ~OutputMessage()
     {
-        delete[] buf_;
+        if (buffer_)
+        {
+            /* Give the buffer back zero-filled, so that alignment padding never carries stale data. */
+            memset(buf_, 0, get_len());
+        }
+        else
+        {
+            delete[] buf_;
+        }
+    }
+
+    /**
+     * @brief Creates a message in pooled memory: its buffer comes from the smallest size class
+     *        that fits, and the object shares a single pooled allocation with its control block.
+     * @param header    The message header.
+     * @param len       The maximum length of the message.
+     * @return  The message.
+     */
+    static std::shared_ptr<OutputMessage> create(
+            const dds::xrce::MessageHeader& header,
+            size_t len)
+    {
+        return std::allocate_shared<OutputMessage>(
+            utils::PoolAllocator<OutputMessage>(get_object_pool()), header, len);
+    }
+
+    static std::shared_ptr<OutputMessage> create(
+            const uint8_t* buf,
+            size_t len,
+            size_t max_len)
+    {
+        return std::allocate_shared<OutputMessage>(
+            utils::PoolAllocator<OutputMessage>(get_object_pool()), buf, len, max_len);
+    }
+
+    /**
+     * Number of heap allocations done for the messages, which stops growing in steady state.
+     * It includes the buffers larger than every size class, allocated on each message.
+     */
+    static uint64_t get_allocations()
+    {
+        uint64_t allocations = get_object_pool().get_allocations();
+        allocations += get_unpooled_allocations().load(std::memory_order_relaxed);
+        for (utils::BufferPool* pool : get_buffer_pools())
+        {
+            allocations += pool->get_allocations();
+        }
+        return allocations;
     }
 
+    /** Number of messages created through create(). */
+    static uint64_t get_creations() { return get_object_pool().get_acquisitions(); }
+
     OutputMessage(OutputMessage&&) = delete;
     OutputMessage(const OutputMessage&) = delete;
     OutputMessage& operator=(OutputMessage&&) = delete;
@@ -53,12 +132,33 @@ public:
 
     size_t get_len() const { return serializer_.getSerializedDataLength(); }
 
+    /**
+     * @brief Checks whether a submessage fits in the remaining space, once aligned to 4 bytes.
+     * @param payload_len   The length of the submessage payload, without its 4-byte subheader.
+     * @return  true if it fits and false in other case.
+     */
+    bool fits_submessage(size_t payload_len) const
+    {
+        return ((get_len() + 3) & ~size_t(3)) + 4 + payload_len <= len_;
+    }
+
     template<class T>
     bool append_submessage(
             dds::xrce::SubmessageId submessage_id,
             const T& data,
             uint8_t flags = 0x01);
 
+    /**
+     * @brief Appends a submessage whose serialized size is already known by the caller.
+     * @param submessage_len    The serialized size of the payload, as given by get_serialized_size().
+     */
+    template<class T>
+    bool append_sized_submessage(
+            dds::xrce::SubmessageId submessage_id,
+            const T& data,
+            size_t submessage_len,
+            uint8_t flags = 0x01);
+
     bool append_raw_payload(
             dds::xrce::SubmessageId submessage_id,
             const uint8_t* buf,
@@ -70,6 +170,14 @@ public:
             uint8_t* buf,
             size_t len);
 
+    /**
+     * @brief Appends an already serialized submessage, aligned to 4 bytes.
+     * @return  The appended bytes, to be patched in place, or nullptr if they do not fit.
+     */
+    uint8_t* append_serialized(
+            const uint8_t* buf,
+            size_t len);
+
 private:
     bool append_subheader(
             dds::xrce::SubmessageId submessage_id,
@@ -81,7 +189,53 @@ private:
 
     void log_error();
 
+    static utils::PooledBuffer acquire_buffer(
+            size_t len)
+    {
+        for (utils::BufferPool* pool : get_buffer_pools())
+        {
+            if (len <= pool->get_buffer_size())
+            {
+                return pool->acquire();
+            }
+        }
+        return utils::PooledBuffer();
+    }
+
+    static uint8_t* allocate_unpooled(
+            size_t len)
+    {
+        get_unpooled_allocations().fetch_add(1, std::memory_order_relaxed);
+        return new uint8_t[len]{0};
+    }
+
+    static std::atomic<uint64_t>& get_unpooled_allocations()
+    {
+        static std::atomic<uint64_t> allocations{0};
+        return allocations;
+    }
+
+    static const std::array<utils::BufferPool*, 4>& get_buffer_pools()
+    {
+        /* Size classes for control submessages (ACKNACK, HEARTBEAT, STATUS...) and usual MTUs.
+           Never destroyed, so that they outlive every message. */
+        static const std::array<utils::BufferPool*, 4> pools{{
+            new utils::BufferPool(64, 1024),
+            new utils::BufferPool(512, 1024),
+            new utils::BufferPool(2048, 256),
+            new utils::BufferPool(8192, 64)}};
+        return pools;
+    }
+
+    static utils::BufferPool& get_object_pool()
+    {
+        /* Room for the message along with the shared_ptr control block. */
+        static utils::BufferPool* pool = new utils::BufferPool(sizeof(OutputMessage) + 64, 1024);
+        return *pool;
+    }
+
 private:
+    utils::PooledBuffer buffer_;
     uint8_t* buf_;
     size_t len_;
     fastcdr::FastBuffer fastbuffer_;
@@ -93,9 +247,19 @@ inline bool OutputMessage::append_submessage(
         dds::xrce::SubmessageId submessage_id,
         const T& data,
         uint8_t flags)
+{
+    return append_sized_submessage(submessage_id, data, get_serialized_size(data), flags);
+}
+
+template<class T>
+inline bool OutputMessage::append_sized_submessage(
+        dds::xrce::SubmessageId submessage_id,
+        const T& data,
+        size_t submessage_len,
+        uint8_t flags)
 {
     bool rv = false;
-    if (append_subheader(submessage_id, flags, data.getCdrSerializedSize()))
+    if (append_subheader(submessage_id, flags, submessage_len))
     {
         rv = serialize(data);
     }
@@ -151,6 +315,25 @@ inline bool OutputMessage::append_fragment(
     return rv;
 }
 
+inline uint8_t* OutputMessage::append_serialized(
+        const uint8_t* buf,
+        size_t len)
+{
+    uint8_t* rv = nullptr;
+    try
+    {
+        serializer_.jump((4 - ((serializer_.getCurrentPosition() - serializer_.getBufferPointer()) & 3)) & 3);
+        uint8_t* position = reinterpret_cast<uint8_t*>(serializer_.getCurrentPosition());
+        serializer_.serializeArray(buf, len);
+        rv = position;
+    }
+    catch(eprosima::fastcdr::exception::NotEnoughMemoryException & /*exception*/)
+    {
+        log_error();
+    }
+    return rv;
+}
+
 inline bool OutputMessage::append_subheader(
         dds::xrce::SubmessageId submessage_id,
         uint8_t flags,
@@ -18,6 +18,7 @@
 #include <uxr/agent/message/InputMessage.hpp>
 #include <uxr/agent/message/OutputMessage.hpp>
 #include <memory>
+#include <chrono>
 
 namespace eprosima {
 namespace uxr {
@@ -29,6 +30,7 @@ struct InputPacket
 {
     EndPoint source;
     InputMessagePtr message;
+    std::chrono::steady_clock::time_point timestamp; // Reception time.
 };
 
 typedef std::shared_ptr<OutputMessage> OutputMessagePtr;
@@ -38,8 +40,18 @@ struct OutputPacket
 {
     EndPoint destination;
     OutputMessagePtr message;
+    std::chrono::steady_clock::time_point timestamp; // Reception time of the packet replied, if any.
 };
 
+/**
+ * Output traffic classes, used as scheduling priority (the higher, the sooner they are sent).
+ * HEARTBEATs go in the reliable class, behind the messages they announce.
+ */
+const uint8_t OUTPUT_PRIORITY_BEST_EFFORT = 0;
+const uint8_t OUTPUT_PRIORITY_RELIABLE = 1;
+const uint8_t OUTPUT_PRIORITY_CONTROL = 2;
+const uint8_t OUTPUT_PRIORITY_LEVELS = 3;
+
 } // namespace uxr
 } // namespace eprosima
 
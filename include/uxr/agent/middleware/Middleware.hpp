@@ -150,6 +150,12 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) = 0;
 
+    /* Writes the data straight from the buffer it was received in, which is only borrowed during the call. */
+    virtual bool write_data(
+            uint16_t datawriter_id,
+            const uint8_t* buf,
+            size_t len) = 0;
+
     virtual bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
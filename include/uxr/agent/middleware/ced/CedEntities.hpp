@@ -121,7 +121,8 @@ public:
 
 private:
     bool write(
-            const std::vector<uint8_t>& data,
+            const uint8_t* buf,
+            size_t len,
             WriteAccess write_access,
             TopicSource topic_src,
             uint8_t& errcode);
@@ -266,6 +267,11 @@ public:
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const;
 
+    bool write(
+        const uint8_t* buf,
+        size_t len,
+        uint8_t& errcode) const;
+
     const std::string& topic_name() const { return topic_->get_global_topic()->name(); }
 
 private:
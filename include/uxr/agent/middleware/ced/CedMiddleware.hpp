@@ -311,6 +311,18 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    /**
+     * @brief Writes data, pointed to by buf, using the CedDataWriter identified by the datawriter_id parameter.
+     * @param datawriter_id The CedDataWriter identifier.
+     * @param buf           The data to be written.
+     * @param len           The length of the data.
+     * @return  true in case of successful writing and false in other case.
+     */
+    bool write_data(
+            uint16_t datawriter_id,
+            const uint8_t* buf,
+            size_t len) override;
+
     /**
      * @brief Not implemented.
      */
@@ -205,7 +205,12 @@ public:
             const std::vector<uint8_t>& data);
 
     bool write(
-            const std::vector<uint8_t>& data,
+            const uint8_t* buf,
+            size_t len);
+
+    bool write(
+            const uint8_t* buf,
+            size_t len,
             fastrtps::rtps::WriteParams& wparams);
 
     const fastrtps::rtps::GUID_t& get_guid() const;
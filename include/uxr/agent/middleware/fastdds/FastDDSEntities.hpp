@@ -263,6 +263,7 @@ public:
     bool create_by_xml(const std::string& xml);
     bool match(const fastrtps::PublisherAttributes& attrs) const;
     bool write(const std::vector<uint8_t>& data);
+    bool write(const uint8_t* buf, size_t len);
     const fastdds::dds::DataWriter* ptr() const;
     const fastdds::dds::DomainParticipant* participant() const;
 
@@ -134,6 +134,11 @@ public:
             uint16_t datawriter_id,
             const std::vector<uint8_t>& data) override;
 
+    bool write_data(
+            uint16_t datawriter_id,
+            const uint8_t* buf,
+            size_t len) override;
+
     bool write_request(
             uint16_t requester_id,
             uint32_t sequence_number,
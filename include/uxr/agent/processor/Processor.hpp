@@ -16,10 +16,13 @@
 #define UXR_AGENT_PROCESSOR_PROCESSOR_HPP_
 
 #include <uxr/agent/middleware/Middleware.hpp>
+#include <uxr/agent/utils/TimerWheel.hpp>
 
+#include <array>
 #include <cstdint>
 #include <vector>
 #include <mutex>
+#include <chrono>
 
 namespace dds {
 namespace xrce {
@@ -126,10 +129,62 @@ private:
             const std::vector<uint8_t>& buffer,
             std::chrono::milliseconds timeout);
 
+    void arm_heartbeat(
+            const ProxyClient& client,
+            uint8_t stream_id);
+
+    void disarm_heartbeat(
+            const ProxyClient& client,
+            uint8_t stream_id);
+
+    void arm_flush(
+            const ProxyClient& client,
+            uint8_t stream_id,
+            std::chrono::milliseconds budget);
+
+    void flush_output_stream(
+            ProxyClient& client,
+            uint8_t stream_id);
+
+    void arm_acknack(
+            const ProxyClient& client,
+            uint8_t stream_id,
+            std::chrono::milliseconds delay);
+
+    void send_acknack(
+            ProxyClient& client,
+            uint8_t stream_id,
+            const EndPoint& destination);
+
+    uint64_t get_heartbeat_tick() const;
+
+    /* Timers are spread over independently locked wheels by client, so that arming them only
+       contends with the timer thread and with threads serving clients of the same wheel. */
+    struct TimerShard
+    {
+        utils::TimerWheel timers;
+        std::mutex mtx;
+    };
+
+    static constexpr size_t TIMER_SHARDS = 16;
+
+    void arm_timer(
+            uint64_t key,
+            uint64_t delay);
+
+    void disarm_timer(
+            uint64_t key);
+
 private:
     Server<EndPoint>& server_;
     Middleware::Kind middleware_kind_;
     Root& root_;
+    const std::chrono::steady_clock::time_point heartbeat_epoch_;
+    std::array<TimerShard, TIMER_SHARDS> timer_shards_;
+    std::vector<uint64_t> expired_heartbeats_;
+    std::vector<uint64_t> expired_flushes_;
+    std::vector<uint64_t> expired_acknacks_;
+    std::vector<dds::xrce::HEARTBEAT_Payload> heartbeats_;
 };
 
 } // namespace uxr
@@ -17,12 +17,15 @@
 
 #include <uxr/agent/types/XRCETypes.hpp>
 #include <uxr/agent/utils/TokenBucket.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
+#include <uxr/agent/utils/Conversion.hpp>
 
 #include <atomic>
 #include <thread>
 #include <mutex>
 #include <chrono>
 #include <type_traits>
+#include <cstdio>
 
 namespace eprosima {
 namespace uxr {
@@ -135,6 +138,11 @@ inline void Reader<RA, WA>::read_task(
 
     constexpr std::chrono::milliseconds max_timeout{rw_timeout};
 
+    char thread_name[16];
+    std::snprintf(thread_name, sizeof(thread_name), "uxr-rd-%08x",
+        static_cast<unsigned int>(conversion::clientkey_to_raw(write_args_.client_key)));
+    configure_current_thread(ThreadKind::READER, thread_name);
+
     size_t rate = (max_bytes_per_second_unlimited == delivery_control_.max_bytes_per_second())
         ? SIZE_MAX
         : delivery_control_.max_bytes_per_second();
@@ -0,0 +1,308 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_SCHEDULER_DRR_SCHEDULER_HPP_
+#define UXR_AGENT_SCHEDULER_DRR_SCHEDULER_HPP_
+
+#include <uxr/agent/scheduler/Scheduler.hpp>
+
+#include <functional>
+#include <map>
+#include <deque>
+#include <utility>
+#include <mutex>
+#include <condition_variable>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Fair queueing scheduler: elements are classified into flows (e.g. by destination), each flow
+ * has its own FCFS queue and active flows are served by deficit round robin. In every round a flow
+ * earns quantum * weight bytes of credit, so the bandwidth is shared in proportion to the weights.
+ * When the scheduler is full and the overflow policy drops old elements, they are taken from the
+ * longest flow.
+ */
+template<class T, class Key>
+class DRRScheduler : public Scheduler<T>
+{
+public:
+    using FlowFn = std::function<Key (const T&)>;
+    using CostFn = std::function<size_t (const T&)>;
+    using WeightFn = std::function<uint16_t (const Key&)>;
+
+    DRRScheduler(
+            size_t max_size,
+            size_t quantum,
+            FlowFn flow_fn,
+            CostFn cost_fn,
+            WeightFn weight_fn = nullptr)
+        : flows_()
+        , active_flows_()
+        , size_{0}
+        , mtx_()
+        , cond_var_()
+        , full_cond_var_()
+        , running_cond_(false)
+        , max_size_{max_size}
+        , quantum_{quantum}
+        , flow_fn_(std::move(flow_fn))
+        , cost_fn_(std::move(cost_fn))
+        , weight_fn_(std::move(weight_fn))
+    {}
+
+    void init() final;
+
+    void deinit() final;
+
+    void push(
+            T&& element,
+            uint8_t priority) final;
+
+    bool pop(
+            T& element) final;
+
+    bool try_pop(
+            T& element) final;
+
+private:
+    struct Flow
+    {
+        std::deque<std::pair<T, uint8_t>> queue;
+        size_t deficit;
+        size_t credit;
+    };
+
+    void dequeue(
+            T& element);
+
+    bool make_room(
+            std::unique_lock<std::mutex>& lock,
+            const T& element,
+            uint8_t priority);
+
+    void drop_from_longest_flow(
+            bool best_effort_first);
+
+private:
+    std::map<Key, Flow> flows_;
+    std::deque<Key> active_flows_;
+    size_t size_;
+    std::mutex mtx_;
+    std::condition_variable cond_var_;
+    std::condition_variable full_cond_var_;
+    bool running_cond_;
+    const size_t max_size_;
+    const size_t quantum_;
+    FlowFn flow_fn_;
+    CostFn cost_fn_;
+    WeightFn weight_fn_;
+};
+
+template<class T, class Key>
+inline void DRRScheduler<T, Key>::init()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = true;
+}
+
+template<class T, class Key>
+inline void DRRScheduler<T, Key>::deinit()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = false;
+    cond_var_.notify_one();
+    full_cond_var_.notify_all();
+}
+
+template<class T, class Key>
+inline void DRRScheduler<T, Key>::push(
+        T&& element,
+        uint8_t priority)
+{
+    Key key = flow_fn_(element);
+    /* The weight is looked up before locking, as it may take other locks (e.g. that of the sessions). */
+    const uint16_t weight = weight_fn_ ? weight_fn_(key) : 1;
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (!make_room(lock, element, priority))
+    {
+        return;
+    }
+
+    auto it = flows_.find(key);
+    if (it == flows_.end())
+    {
+        Flow flow{std::deque<std::pair<T, uint8_t>>{}, 0, quantum_ * ((0 != weight) ? weight : 1)};
+        it = flows_.emplace(key, std::move(flow)).first;
+        active_flows_.push_back(key);
+    }
+    it->second.queue.emplace_back(std::move(element), priority);
+    ++size_;
+    cond_var_.notify_one();
+}
+
+template<class T, class Key>
+inline bool DRRScheduler<T, Key>::pop(
+        T& element)
+{
+    bool rv = false;
+    std::unique_lock<std::mutex> lock(mtx_);
+    cond_var_.wait(lock, [this] { return !((0 == size_) && running_cond_); });
+    if (running_cond_)
+    {
+        dequeue(element);
+        rv = true;
+    }
+    return rv;
+}
+
+template<class T, class Key>
+inline bool DRRScheduler<T, Key>::try_pop(
+        T& element)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (running_cond_ && (0 != size_))
+    {
+        dequeue(element);
+        rv = true;
+    }
+    return rv;
+}
+
+template<class T, class Key>
+inline void DRRScheduler<T, Key>::dequeue(
+        T& element)
+{
+    for (;;)
+    {
+        auto it = flows_.find(active_flows_.front());
+        Flow& flow = it->second;
+        size_t cost = cost_fn_(flow.queue.front().first);
+        if (cost <= flow.deficit)
+        {
+            flow.deficit -= cost;
+            element = std::move(flow.queue.front().first);
+            flow.queue.pop_front();
+            --size_;
+            if (flow.queue.empty())
+            {
+                flows_.erase(it);
+                active_flows_.pop_front();
+            }
+            break;
+        }
+
+        /* Not enough credit, earn this round's quantum and let the next flow go. */
+        flow.deficit += flow.credit;
+        active_flows_.push_back(active_flows_.front());
+        active_flows_.pop_front();
+    }
+    if (OverflowPolicy::BLOCK == this->overflow_policy_)
+    {
+        full_cond_var_.notify_one();
+    }
+}
+
+template<class T, class Key>
+inline bool DRRScheduler<T, Key>::make_room(
+        std::unique_lock<std::mutex>& lock,
+        const T& element,
+        uint8_t priority)
+{
+    bool rv = true;
+    switch (this->overflow_policy_)
+    {
+        case OverflowPolicy::DROP_OLDEST:
+        case OverflowPolicy::DROP_OLDEST_BEST_EFFORT:
+        {
+            if (max_size_ <= size_)
+            {
+                drop_from_longest_flow(OverflowPolicy::DROP_OLDEST_BEST_EFFORT == this->overflow_policy_);
+            }
+            break;
+        }
+        case OverflowPolicy::DROP_NEWEST:
+        {
+            rv = (size_ < max_size_);
+            break;
+        }
+        case OverflowPolicy::REJECT_BY_CLASS:
+        {
+            rv = this->admitted_by_class(size_, max_size_, priority);
+            break;
+        }
+        case OverflowPolicy::BLOCK:
+        {
+            full_cond_var_.wait(lock, [this] { return !((max_size_ <= size_) && running_cond_); });
+            rv = running_cond_;
+            break;
+        }
+    }
+
+    if (!rv)
+    {
+        this->notify_drop(element);
+    }
+    return rv;
+}
+
+template<class T, class Key>
+inline void DRRScheduler<T, Key>::drop_from_longest_flow(
+        bool best_effort_first)
+{
+    auto longest = flows_.end();
+    for (auto it = flows_.begin(); it != flows_.end(); ++it)
+    {
+        if ((longest == flows_.end()) || (longest->second.queue.size() < it->second.queue.size()))
+        {
+            longest = it;
+        }
+    }
+
+    if (longest != flows_.end())
+    {
+        auto& queue = longest->second.queue;
+        auto victim = queue.begin();
+        if (best_effort_first)
+        {
+            while ((victim != queue.end()) && (0 != victim->second))
+            {
+                ++victim;
+            }
+            victim = (victim != queue.end()) ? victim : queue.begin();
+        }
+        this->notify_drop(victim->first);
+        queue.erase(victim);
+        --size_;
+
+        if (queue.empty())
+        {
+            for (auto it = active_flows_.begin(); it != active_flows_.end(); ++it)
+            {
+                if (!(*it < longest->first) && !(longest->first < *it))
+                {
+                    active_flows_.erase(it);
+                    break;
+                }
+            }
+            flows_.erase(longest);
+        }
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_SCHEDULER_DRR_SCHEDULER_HPP_
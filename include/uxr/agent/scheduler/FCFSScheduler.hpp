@@ -18,6 +18,7 @@
 #include <uxr/agent/scheduler/Scheduler.hpp>
 
 #include <deque>
+#include <utility>
 #include <mutex>
 #include <condition_variable>
 #include <atomic>
@@ -34,6 +35,7 @@ public:
         : deque_()
         , mtx_()
         , cond_var_()
+        , full_cond_var_()
         , running_cond_(false)
         , max_size_{max_size}
     {}
@@ -52,10 +54,20 @@ public:
     bool pop(
             T& element) final;
 
+    bool try_pop(
+            T& element) final;
+
+private:
+    bool make_room(
+            std::unique_lock<std::mutex>& lock,
+            const T& element,
+            uint8_t priority);
+
 private:
-    std::deque<T> deque_;
+    std::deque<std::pair<T, uint8_t>> deque_;
     std::mutex mtx_;
     std::condition_variable cond_var_;
+    std::condition_variable full_cond_var_;
     bool running_cond_;
     const size_t max_size_;
 };
@@ -73,6 +85,7 @@ inline void FCFSScheduler<T>::deinit()
     std::lock_guard<std::mutex> lock(mtx_);
     running_cond_ = false;
     cond_var_.notify_one();
+    full_cond_var_.notify_all();
 }
 
 template<class T>
@@ -80,14 +93,12 @@ inline void FCFSScheduler<T>::push(
         T&& element,
         uint8_t priority)
 {
-    (void) priority;
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (max_size_ <= deque_.size())
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (make_room(lock, element, priority))
     {
-        deque_.pop_front();
+        deque_.emplace_back(std::move(element), priority);
+        cond_var_.notify_one();
     }
-    deque_.push_back(std::move(element));
-    cond_var_.notify_one();
 }
 
 template<class T>
@@ -95,7 +106,7 @@ inline void FCFSScheduler<T>::push_front(
         T&& element)
 {
     std::lock_guard<std::mutex> lock(mtx_);
-    deque_.push_front(std::forward<T>(element));
+    deque_.emplace_front(std::forward<T>(element), 0);
 }
 
 template<class T>
@@ -107,10 +118,91 @@ inline bool FCFSScheduler<T>::pop(
     cond_var_.wait(lock, [this] { return !(deque_.empty() && running_cond_); });
     if (running_cond_)
     {
-        element = std::move(deque_.front());
+        element = std::move(deque_.front().first);
         deque_.pop_front();
         rv = true;
         cond_var_.notify_one();
+        if (OverflowPolicy::BLOCK == this->overflow_policy_)
+        {
+            full_cond_var_.notify_one();
+        }
+    }
+    return rv;
+}
+
+template<class T>
+inline bool FCFSScheduler<T>::try_pop(
+        T& element)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (running_cond_ && !deque_.empty())
+    {
+        element = std::move(deque_.front().first);
+        deque_.pop_front();
+        rv = true;
+        if (OverflowPolicy::BLOCK == this->overflow_policy_)
+        {
+            full_cond_var_.notify_one();
+        }
+    }
+    return rv;
+}
+
+template<class T>
+inline bool FCFSScheduler<T>::make_room(
+        std::unique_lock<std::mutex>& lock,
+        const T& element,
+        uint8_t priority)
+{
+    bool rv = true;
+    switch (this->overflow_policy_)
+    {
+        case OverflowPolicy::DROP_OLDEST:
+        {
+            if (max_size_ <= deque_.size())
+            {
+                this->notify_drop(deque_.front().first);
+                deque_.pop_front();
+            }
+            break;
+        }
+        case OverflowPolicy::DROP_NEWEST:
+        {
+            rv = (deque_.size() < max_size_);
+            break;
+        }
+        case OverflowPolicy::DROP_OLDEST_BEST_EFFORT:
+        {
+            if (max_size_ <= deque_.size())
+            {
+                auto it = deque_.begin();
+                while ((it != deque_.end()) && (0 != it->second))
+                {
+                    ++it;
+                }
+                it = (it != deque_.end()) ? it : deque_.begin();
+                this->notify_drop(it->first);
+                deque_.erase(it);
+            }
+            break;
+        }
+        case OverflowPolicy::REJECT_BY_CLASS:
+        {
+            rv = this->admitted_by_class(deque_.size(), max_size_, priority);
+            break;
+        }
+        case OverflowPolicy::BLOCK:
+        {
+            full_cond_var_.wait(lock, [this] { return !((max_size_ <= deque_.size()) && running_cond_); });
+            rv = running_cond_;
+            break;
+        }
+    }
+
+    if (!rv)
+    {
+        this->notify_drop(element);
     }
     return rv;
 }
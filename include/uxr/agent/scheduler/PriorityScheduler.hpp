@@ -0,0 +1,219 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_SCHEDULER_PRIORITY_SCHEDULER_HPP_
+#define UXR_AGENT_SCHEDULER_PRIORITY_SCHEDULER_HPP_
+
+#include <uxr/agent/scheduler/Scheduler.hpp>
+
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Multi-level scheduler: elements are served FCFS within a level, and a level is only served when
+ * all the higher ones are empty. Priorities above the highest level are clamped to it.
+ * When the scheduler is full and the overflow policy drops old elements, the oldest element of the
+ * lowest non-empty level is discarded.
+ */
+template<class T>
+class PriorityScheduler : public Scheduler<T>
+{
+public:
+    PriorityScheduler(
+            size_t max_size,
+            uint8_t levels)
+        : levels_(std::max<uint8_t>(levels, 1))
+        , size_{0}
+        , mtx_()
+        , cond_var_()
+        , full_cond_var_()
+        , running_cond_(false)
+        , max_size_{max_size}
+    {}
+
+    void init() final;
+
+    void deinit() final;
+
+    void push(
+            T&& element,
+            uint8_t priority) final;
+
+    bool pop(
+            T& element) final;
+
+    bool try_pop(
+            T& element) final;
+
+private:
+    void dequeue(
+            T& element);
+
+    bool make_room(
+            std::unique_lock<std::mutex>& lock,
+            const T& element,
+            uint8_t priority);
+
+private:
+    std::vector<std::deque<T>> levels_;
+    size_t size_;
+    std::mutex mtx_;
+    std::condition_variable cond_var_;
+    std::condition_variable full_cond_var_;
+    bool running_cond_;
+    const size_t max_size_;
+};
+
+template<class T>
+inline void PriorityScheduler<T>::init()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = true;
+}
+
+template<class T>
+inline void PriorityScheduler<T>::deinit()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = false;
+    cond_var_.notify_one();
+    full_cond_var_.notify_all();
+}
+
+template<class T>
+inline void PriorityScheduler<T>::push(
+        T&& element,
+        uint8_t priority)
+{
+    std::unique_lock<std::mutex> lock(mtx_);
+    if (make_room(lock, element, priority))
+    {
+        size_t index = std::min<size_t>(priority, levels_.size() - 1);
+        levels_[index].push_back(std::move(element));
+        ++size_;
+        cond_var_.notify_one();
+    }
+}
+
+template<class T>
+inline bool PriorityScheduler<T>::pop(
+        T& element)
+{
+    bool rv = false;
+    std::unique_lock<std::mutex> lock(mtx_);
+    cond_var_.wait(lock, [this] { return !((0 == size_) && running_cond_); });
+    if (running_cond_)
+    {
+        dequeue(element);
+        rv = true;
+    }
+    return rv;
+}
+
+template<class T>
+inline bool PriorityScheduler<T>::try_pop(
+        T& element)
+{
+    bool rv = false;
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (running_cond_ && (0 != size_))
+    {
+        dequeue(element);
+        rv = true;
+    }
+    return rv;
+}
+
+template<class T>
+inline void PriorityScheduler<T>::dequeue(
+        T& element)
+{
+    for (auto it = levels_.rbegin(); it != levels_.rend(); ++it)
+    {
+        if (!it->empty())
+        {
+            element = std::move(it->front());
+            it->pop_front();
+            --size_;
+            break;
+        }
+    }
+    if (OverflowPolicy::BLOCK == this->overflow_policy_)
+    {
+        full_cond_var_.notify_one();
+    }
+}
+
+template<class T>
+inline bool PriorityScheduler<T>::make_room(
+        std::unique_lock<std::mutex>& lock,
+        const T& element,
+        uint8_t priority)
+{
+    bool rv = true;
+    switch (this->overflow_policy_)
+    {
+        case OverflowPolicy::DROP_OLDEST:
+        case OverflowPolicy::DROP_OLDEST_BEST_EFFORT:
+        {
+            if (max_size_ <= size_)
+            {
+                for (auto& level : levels_)
+                {
+                    if (!level.empty())
+                    {
+                        this->notify_drop(level.front());
+                        level.pop_front();
+                        --size_;
+                        break;
+                    }
+                }
+            }
+            break;
+        }
+        case OverflowPolicy::DROP_NEWEST:
+        {
+            rv = (size_ < max_size_);
+            break;
+        }
+        case OverflowPolicy::REJECT_BY_CLASS:
+        {
+            rv = this->admitted_by_class(size_, max_size_, priority);
+            break;
+        }
+        case OverflowPolicy::BLOCK:
+        {
+            full_cond_var_.wait(lock, [this] { return !((max_size_ <= size_) && running_cond_); });
+            rv = running_cond_;
+            break;
+        }
+    }
+
+    if (!rv)
+    {
+        this->notify_drop(element);
+    }
+    return rv;
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_SCHEDULER_PRIORITY_SCHEDULER_HPP_
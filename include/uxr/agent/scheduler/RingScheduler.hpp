@@ -0,0 +1,310 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_SCHEDULER_RING_SCHEDULER_HPP_
+#define UXR_AGENT_SCHEDULER_RING_SCHEDULER_HPP_
+
+#include <uxr/agent/scheduler/Scheduler.hpp>
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <thread>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Bounded lock-free queue based on a preallocated ring of cells, each one tagged with a sequence
+ * number (D. Vyukov's MPMC algorithm). Producers and consumers only synchronize through atomics,
+ * the mutex and condition variable are touched only when a consumer is parked on an empty ring.
+ * Elements carry no class once queued, so DROP_OLDEST_BEST_EFFORT discards an incoming best-effort
+ * element and makes room for the rest, and BLOCK makes the producer yield until there is room.
+ */
+template<class T>
+class RingScheduler : public Scheduler<T>
+{
+public:
+    RingScheduler(
+            size_t max_size)
+        : cells_(new Cell[round_capacity(max_size)])
+        , mask_{round_capacity(max_size) - 1}
+        , enqueue_pos_{0}
+        , dequeue_pos_{0}
+        , running_cond_{false}
+        , parked_{0}
+        , mtx_()
+        , cond_var_()
+    {
+        for (size_t i = 0; i <= mask_; ++i)
+        {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    void init() final;
+
+    void deinit() final;
+
+    void push(
+            T&& element,
+            uint8_t priority) final;
+
+    bool pop(
+            T& element) final;
+
+    bool try_pop(
+            T& element) final;
+
+    size_t capacity() const { return mask_ + 1; }
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T element;
+    };
+
+    static size_t round_capacity(
+            size_t max_size);
+
+    bool try_push(
+            T& element);
+
+    bool empty() const;
+
+    size_t size() const;
+
+    void wake_consumer();
+
+private:
+    std::unique_ptr<Cell[]> cells_;
+    const size_t mask_;
+    std::atomic<size_t> enqueue_pos_;
+    char enqueue_pad_[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> dequeue_pos_;
+    char dequeue_pad_[64 - sizeof(std::atomic<size_t>)];
+    std::atomic<bool> running_cond_;
+    std::atomic<uint32_t> parked_;
+    std::mutex mtx_;
+    std::condition_variable cond_var_;
+};
+
+template<class T>
+inline size_t RingScheduler<T>::round_capacity(
+        size_t max_size)
+{
+    size_t capacity = 2;
+    while (capacity < max_size)
+    {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+template<class T>
+inline void RingScheduler<T>::init()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = true;
+}
+
+template<class T>
+inline void RingScheduler<T>::deinit()
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    running_cond_ = false;
+    cond_var_.notify_all();
+}
+
+template<class T>
+inline void RingScheduler<T>::push(
+        T&& element,
+        uint8_t priority)
+{
+    bool admitted = true;
+    switch (this->overflow_policy_)
+    {
+        case OverflowPolicy::DROP_NEWEST:
+        {
+            admitted = try_push(element);
+            break;
+        }
+        case OverflowPolicy::REJECT_BY_CLASS:
+        {
+            admitted = this->admitted_by_class(size(), mask_ + 1, priority) && try_push(element);
+            break;
+        }
+        case OverflowPolicy::BLOCK:
+        {
+            while (!try_push(element))
+            {
+                if (!running_cond_)
+                {
+                    admitted = false;
+                    break;
+                }
+                std::this_thread::yield();
+            }
+            break;
+        }
+        case OverflowPolicy::DROP_OLDEST_BEST_EFFORT:
+        {
+            if (0 == priority)
+            {
+                admitted = try_push(element);
+                break;
+            }
+        }
+        /* fall through */
+        case OverflowPolicy::DROP_OLDEST:
+        {
+            while (!try_push(element))
+            {
+                T discarded;
+                if (try_pop(discarded))
+                {
+                    this->notify_drop(discarded);
+                }
+            }
+            break;
+        }
+    }
+
+    if (admitted)
+    {
+        wake_consumer();
+    }
+    else
+    {
+        this->notify_drop(element);
+    }
+}
+
+template<class T>
+inline bool RingScheduler<T>::pop(
+        T& element)
+{
+    bool rv = false;
+    while (running_cond_)
+    {
+        if (try_pop(element))
+        {
+            rv = true;
+            break;
+        }
+
+        std::unique_lock<std::mutex> lock(mtx_);
+        parked_.fetch_add(1);
+        cond_var_.wait(lock, [this] { return !(empty() && running_cond_); });
+        parked_.fetch_sub(1);
+    }
+    return rv;
+}
+
+template<class T>
+inline bool RingScheduler<T>::try_push(
+        T& element)
+{
+    size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells_[pos & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = intptr_t(sequence) - intptr_t(pos);
+        if (0 == diff)
+        {
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                cell.element = std::move(element);
+                cell.sequence.store(pos + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (0 > diff)
+        {
+            return false;
+        }
+        else
+        {
+            pos = enqueue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<class T>
+inline bool RingScheduler<T>::try_pop(
+        T& element)
+{
+    size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells_[pos & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        intptr_t diff = intptr_t(sequence) - intptr_t(pos + 1);
+        if (0 == diff)
+        {
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                element = std::move(cell.element);
+                cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (0 > diff)
+        {
+            return false;
+        }
+        else
+        {
+            pos = dequeue_pos_.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+template<class T>
+inline bool RingScheduler<T>::empty() const
+{
+    return dequeue_pos_.load() == enqueue_pos_.load();
+}
+
+template<class T>
+inline size_t RingScheduler<T>::size() const
+{
+    /* The dequeue position is loaded first, as it never passes the enqueue one. Both may still move
+       in between, so the difference is clamped instead of letting it wrap around. */
+    const size_t dequeue_pos = dequeue_pos_.load();
+    const size_t enqueue_pos = enqueue_pos_.load();
+    return (enqueue_pos < dequeue_pos) ? 0 : std::min(enqueue_pos - dequeue_pos, mask_ + 1);
+}
+
+template<class T>
+inline void RingScheduler<T>::wake_consumer()
+{
+    /* Pairs with the parked_ increment in pop, so that either the producer sees the parked
+     * consumer or the consumer sees the new element before waiting. */
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (0 < parked_.load(std::memory_order_relaxed))
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        cond_var_.notify_one();
+    }
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_SCHEDULER_RING_SCHEDULER_HPP_
@@ -16,21 +16,126 @@
 #define _UXR_AGENT_SCHEDULER_SCHEDULER_HPP_
 
 #include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
 
+enum class SchedulerKind : uint8_t
+{
+    FCFS,
+    RING,
+    PRIORITY,
+    DRR
+};
+
+/**
+ * Behaviour of a scheduler when an element is pushed and the scheduler is full.
+ * Priorities are interpreted as classes, the lowest one (0) being best-effort traffic.
+ */
+enum class OverflowPolicy : uint8_t
+{
+    DROP_OLDEST,                /* Discard the oldest element to make room. */
+    DROP_NEWEST,                /* Discard the incoming element. */
+    DROP_OLDEST_BEST_EFFORT,    /* Discard the oldest best-effort element, or the oldest one if there is none. */
+    REJECT_BY_CLASS,            /* Admit each class only up to its share of the scheduler. */
+    BLOCK                       /* Wait until there is room. */
+};
+
+const size_t OVERFLOW_POLICY_COUNT = 5;
+
 template<class T>
 class Scheduler
 {
 public:
-    Scheduler() = default;
+    using DropHandler = std::function<void (const T& element, OverflowPolicy policy)>;
+
+    Scheduler()
+        : overflow_policy_(OverflowPolicy::DROP_OLDEST)
+        , priority_levels_(1)
+        , drop_handler_()
+    {}
+
     virtual ~Scheduler() {}
 
     virtual void init() = 0;
     virtual void deinit() = 0;
     virtual void push(T&& element, uint8_t priority) = 0;
     virtual bool pop(T& element) = 0;
+
+    /**
+     * @brief Pops an element without waiting for it.
+     * @param element   The popped element.
+     * @return  true if an element was popped, false if the scheduler is empty or stopped.
+     */
+    virtual bool try_pop(T& element) = 0;
+
+    /**
+     * @brief Waits for an element and pops it along with those already queued behind it.
+     * @param elements      The popped elements are appended to this vector.
+     * @param max_elements  The maximum number of elements to pop.
+     * @return  The number of popped elements, zero if the scheduler was stopped.
+     */
+    size_t pop_batch(
+            std::vector<T>& elements,
+            size_t max_elements)
+    {
+        size_t count = 0;
+        T element;
+        if ((0 < max_elements) && pop(element))
+        {
+            elements.push_back(std::move(element));
+            ++count;
+            while ((count < max_elements) && try_pop(element))
+            {
+                elements.push_back(std::move(element));
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    /**
+     * @brief Sets the overflow policy. It shall be called before init.
+     * @param policy            The overflow policy.
+     * @param priority_levels   The number of classes considered by REJECT_BY_CLASS.
+     * @param drop_handler      Called for every discarded element.
+     */
+    void set_overflow_policy(
+            OverflowPolicy policy,
+            uint8_t priority_levels = 1,
+            DropHandler drop_handler = nullptr)
+    {
+        overflow_policy_ = policy;
+        priority_levels_ = (0 != priority_levels) ? priority_levels : 1;
+        drop_handler_ = std::move(drop_handler);
+    }
+
+protected:
+    /* Class c is admitted while the occupancy is below (c + 1) / priority_levels of max_size. */
+    bool admitted_by_class(
+            size_t size,
+            size_t max_size,
+            uint8_t priority) const
+    {
+        size_t level = (priority < priority_levels_) ? priority : (priority_levels_ - 1u);
+        return size < (max_size * (level + 1)) / priority_levels_;
+    }
+
+    void notify_drop(const T& element) const
+    {
+        if (drop_handler_)
+        {
+            drop_handler_(element, overflow_policy_);
+        }
+    }
+
+protected:
+    OverflowPolicy overflow_policy_;
+    uint8_t priority_levels_;
+    DropHandler drop_handler_;
 };
 
 } // namespace uxr
@@ -18,11 +18,18 @@
 #include <uxr/agent/Agent.hpp>
 #include <uxr/agent/transport/TransportRc.hpp>
 #include <uxr/agent/transport/SessionManager.hpp>
-#include <uxr/agent/scheduler/FCFSScheduler.hpp>
+#include <uxr/agent/scheduler/Scheduler.hpp>
 #include <uxr/agent/message/Packet.hpp>
 #include <uxr/agent/processor/Processor.hpp>
+#include <uxr/agent/utils/LatencyHistogram.hpp>
 
 #include <thread>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+#include <memory>
 
 namespace eprosima {
 namespace uxr {
@@ -30,6 +37,20 @@ namespace uxr {
 template<typename EndPoint>
 class Processor;
 
+/**
+ * Threading model of the Server.
+ * In the THREADED mode, reception, processing and sending run in their own threads connected by queues.
+ * In the EVENT_LOOP mode, a single thread (one per receiver) receives each packet, processes it and
+ * sends the replies inline, and the first one also serves the heartbeat timers. Only the packets
+ * produced out of those threads, such as the data delivered by the DataReaders, are handed over to
+ * the sender thread.
+ */
+enum class ExecutionMode : uint8_t
+{
+    THREADED,
+    EVENT_LOOP
+};
+
 template<typename EndPoint>
 class Server : public Agent, public SessionManager<EndPoint>
 {
@@ -42,6 +63,185 @@ public:
     UXR_AGENT_EXPORT bool start();
     UXR_AGENT_EXPORT bool stop();
 
+    /**
+     * @brief Sets the number of threads processing the incoming packets.
+     *        Packets are distributed among them by client key (or by source endpoint for those
+     *        without client key), so that the order within a session is preserved.
+     *        It shall be called before starting the server.
+     * @param processing_threads    The number of processing threads, at least one.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_processing_threads(uint16_t processing_threads);
+
+    /**
+     * @brief Sets the number of threads receiving the incoming packets, one per event loop in
+     *        the EVENT_LOOP mode. Transports supporting it open one socket per receiver on the same
+     *        port and let the kernel spread the clients among them, the rest use a single receiver.
+     *        It shall be called before starting the server.
+     * @param receiver_threads  The number of receiver threads, at least one.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_receiver_threads(uint16_t receiver_threads);
+
+    /**
+     * @brief Selects the queue implementation used to hand packets over from the receiver thread
+     *        to the processing threads, and from the processing threads to the sender thread.
+     *        The DRR kind shares the bandwidth among clients according to their "uxr_weight" property;
+     *        on the input queues it shares the processing time among source endpoints in the same way.
+     *        The priority kind is only valid for the output queue, since input packets carry no class.
+     *        It shall be called before starting the server.
+     * @param input_kind    The kind of the input queues, any but SchedulerKind::PRIORITY.
+     * @param output_kind   The kind of the output queue.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_scheduler_kind(
+            SchedulerKind input_kind,
+            SchedulerKind output_kind);
+
+    /**
+     * @brief Sets the behaviour of the input and output queues when they are full.
+     *        It shall be called before starting the server.
+     * @param input_policy  The overflow policy of the input queues.
+     * @param output_policy The overflow policy of the output queue.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_overflow_policy(
+            OverflowPolicy input_policy,
+            OverflowPolicy output_policy);
+
+    /**
+     * @brief Returns the number of packets discarded by the input and output queues due to the given policy.
+     * @param policy    The overflow policy.
+     * @return  The number of discarded packets.
+     */
+    UXR_AGENT_EXPORT uint64_t get_dropped_packets(
+            OverflowPolicy policy) const;
+
+    /**
+     * @brief Returns the number of packets from or to the given endpoint discarded by the input and output queues,
+     *        while a session was established with it. The count is dropped along with the session.
+     * @param endpoint  The client's endpoint.
+     * @return  The number of discarded packets.
+     */
+    UXR_AGENT_EXPORT uint64_t get_dropped_packets(
+            const EndPoint& endpoint);
+
+    /**
+     * @brief Selects the threading model of the server.
+     *        It shall be called before starting the server.
+     * @param mode  The execution mode.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_execution_mode(
+            ExecutionMode mode);
+
+    /**
+     * @brief Returns the given percentile of the time elapsed since a packet is received until
+     *        each of its replies is sent.
+     * @param percentile    The percentile, from 0 to 100.
+     * @return  The latency, zero if no reply has been sent yet.
+     */
+    UXR_AGENT_EXPORT std::chrono::microseconds get_latency(
+            double percentile) const;
+
+    /**
+     * @brief Sets the number of datagrams moved per system call by the transports supporting it.
+     *        The sender thread drains up to send_batch_size packets from the output queue at once.
+     *        It shall be called before starting the server.
+     * @param recv_batch_size   The maximum number of datagrams received per system call, at least one.
+     * @param send_batch_size   The maximum number of datagrams sent per system call, at least one.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_batch_size(
+            uint16_t recv_batch_size,
+            uint16_t send_batch_size);
+
+    /**
+     * @brief Returns the average number of datagrams received per system call.
+     * @return  The ratio, zero if the transport does not report its system calls.
+     */
+    UXR_AGENT_EXPORT double get_recv_packets_per_syscall() const;
+
+    /**
+     * @brief Returns the average number of datagrams sent per system call.
+     * @return  The ratio, zero if the transport does not report its system calls.
+     */
+    UXR_AGENT_EXPORT double get_send_packets_per_syscall() const;
+
+    /**
+     * @brief Sets how long the data delivered to a best-effort or reliable stream may wait for more data
+     *        to share its message. The message is sent once it is full or the budget expires.
+     *        It shall be called before starting the server.
+     * @param budget    The latency budget, zero (the default) to send each sample in its own message.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_aggregation_budget(
+            std::chrono::milliseconds budget);
+
+    /**
+     * @brief Sets how the reception of reliable messages is acknowledged. A single ACKNACK is sent once
+     *        max_messages have been received or max_delay has elapsed since the first one, whichever comes
+     *        first. Missing messages are reported without delay.
+     *        It shall be called before starting the server.
+     * @param max_messages  The number of messages acknowledged together, at least one (the default).
+     *                      More than one requires a non-zero max_delay, which acknowledges a trailing
+     *                      partial batch.
+     * @param max_delay     The maximum delay of an ACKNACK, zero (the default) to send it at once.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_acknack_coalescing(
+            uint16_t max_messages,
+            std::chrono::milliseconds max_delay);
+
+    /**
+     * @brief Sets the default depth of the streams of the sessions created from now on.
+     *        A client may change them through the uxr_reliable_depth and uxr_best_effort_depth properties,
+     *        up to the maximum stream depth.
+     * @param reliable_depth    The number of messages of each reliable window, from 1 to MAX_STREAM_DEPTH.
+     * @param best_effort_depth The number of messages queued by each none or best-effort stream,
+     *                          from 1 to MAX_STREAM_DEPTH.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_stream_depths(
+            uint16_t reliable_depth,
+            uint16_t best_effort_depth);
+
+    /**
+     * @brief Sets the deepest streams a client may ask for through its properties, in the sessions
+     *        created from now on. The default depths are allowed even if they are deeper.
+     * @param max_depth The number of messages, from 1 to MAX_STREAM_DEPTH.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_max_stream_depth(
+            uint16_t max_depth);
+
+    /**
+     * @brief Sets the period of the HEARTBEATs of reliable output streams.
+     *        It shall be called before starting the server.
+     * @param period    The heartbeat period, greater than zero.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_heartbeat_period(
+            std::chrono::milliseconds period);
+
+    /**
+     * @brief Sets the capacity of the input and output queues of the server.
+     *        It shall be called before starting the server.
+     * @param queue_size    The maximum number of packets of each queue, greater than zero.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_queue_size(
+            size_t queue_size);
+
+    /**
+     * @brief Sets how long a client may remain silent before it is considered dead.
+     *        It shall be called before starting the server.
+     * @param dead_time The dead time, greater than zero.
+     * @return  true in case of success and false in other case.
+     */
+    UXR_AGENT_EXPORT bool set_client_dead_time(
+            std::chrono::milliseconds dead_time);
+
 #ifdef UAGENT_DISCOVERY_PROFILE
     UXR_AGENT_EXPORT bool enable_discovery(uint16_t discovery_port = DISCOVERY_PORT);
     UXR_AGENT_EXPORT bool disable_discovery();
@@ -54,7 +254,8 @@ public:
 
 private:
     void push_output_packet(
-            OutputPacket<EndPoint>&& output_packet);
+            OutputPacket<EndPoint>&& output_packet,
+            uint8_t priority);
 
     virtual bool init() = 0;
 
@@ -77,35 +278,106 @@ private:
             int timeout,
             TransportRc& transport_rc) = 0;
 
+    /**
+     * Number of receivers opened by the transport, each one served by its own thread, and reception
+     * from one of them. Transports with a single receiver keep the defaults.
+     */
+    virtual size_t get_receiver_count() const { return 1; }
+
+    virtual bool recv_message_from(
+            size_t receiver_id,
+            InputPacket<EndPoint>& input_packet,
+            int timeout,
+            TransportRc& transport_rc);
+
     virtual bool send_message(
             OutputPacket<EndPoint> output_packet,
             TransportRc& transport_rc) = 0;
 
+    /**
+     * Sends the packets in order and returns the number of them sent, stopping at the first failure.
+     * Transports able to send several datagrams per system call override it.
+     */
+    virtual size_t send_messages(
+            std::vector<OutputPacket<EndPoint>>& output_packets,
+            TransportRc& transport_rc);
+
     virtual bool handle_error(TransportRc transport_rc) = 0;
 
-    void receiver_loop();
+    void receiver_loop(size_t receiver_id);
 
     void sender_loop();
 
-    void processing_loop();
+    void event_loop(size_t receiver_id);
+
+    bool send_output_packet(
+            OutputPacket<EndPoint>& output_packet,
+            TransportRc& transport_rc);
+
+    bool send_output_packets(
+            std::vector<OutputPacket<EndPoint>>& output_packets,
+            TransportRc& transport_rc);
+
+    void processing_loop(size_t worker_id);
+
+    size_t get_processing_worker(const InputPacket<EndPoint>& input_packet) const;
 
     void heartbeat_loop();
 
+    /** Period of the timer checks, short enough to honour the aggregation budget and the ACKNACK delay. */
+    std::chrono::milliseconds get_timer_period() const;
+
     void error_handler_loop();
 
+    void account_dropped_packet(
+            const EndPoint& endpoint,
+            OverflowPolicy policy);
+
+protected:
+    uint16_t get_receiver_threads() const { return receiver_threads_count_; }
+
+    uint16_t get_recv_batch_size() const { return recv_batch_size_; }
+
+    void account_recv_syscall(size_t packets);
+
+    void account_send_syscall(size_t packets);
+
 protected:
     Processor<EndPoint>* processor_;
 
 private:
     std::mutex mtx_;
-    std::thread receiver_thread_;
+    std::vector<std::thread> receiver_threads_;
     std::thread sender_thread_;
-    std::thread processing_thread_;
+    std::vector<std::thread> processing_threads_;
     std::thread heartbeat_thread_;
+    std::vector<std::thread> event_loop_threads_;
     std::thread error_handler_thread_;
     std::atomic<bool> running_cond_;
-    FCFSScheduler<InputPacket<EndPoint>> input_scheduler_;
-    FCFSScheduler<OutputPacket<EndPoint>> output_scheduler_;
+    uint16_t receiver_threads_count_;
+    uint16_t processing_threads_count_;
+    SchedulerKind input_scheduler_kind_;
+    SchedulerKind output_scheduler_kind_;
+    std::vector<std::unique_ptr<Scheduler<InputPacket<EndPoint>>>> input_schedulers_;
+    std::unique_ptr<Scheduler<OutputPacket<EndPoint>>> output_scheduler_;
+    OverflowPolicy input_overflow_policy_;
+    OverflowPolicy output_overflow_policy_;
+    std::array<std::atomic<uint64_t>, OVERFLOW_POLICY_COUNT> dropped_by_policy_;
+    ExecutionMode execution_mode_;
+    utils::LatencyHistogram latency_;
+    std::mutex send_mtx_;
+    uint16_t recv_batch_size_;
+    uint16_t send_batch_size_;
+    std::atomic<uint64_t> recv_packets_;
+    std::atomic<uint64_t> recv_syscalls_;
+    std::atomic<uint64_t> send_packets_;
+    std::atomic<uint64_t> send_syscalls_;
+    std::chrono::milliseconds aggregation_budget_;
+    uint16_t acknack_max_messages_;
+    std::chrono::milliseconds acknack_max_delay_;
+    std::chrono::milliseconds heartbeat_period_;
+    size_t queue_size_;
+    std::chrono::milliseconds client_dead_time_;
     TransportRc transport_rc_;
     std::mutex error_mtx_;
     std::condition_variable error_cv_;
@@ -49,9 +49,26 @@ public:
             uint32_t client_key,
             EndPoint& endpoint);
 
+    void set_output_weight(
+            const EndPoint& endpoint,
+            uint16_t weight);
+
+    uint16_t get_output_weight(
+            const EndPoint& endpoint);
+
+    /* Packets dropped are only counted for endpoints with an established session,
+       so that their number stays bounded by the number of sessions. */
+    void add_dropped_packet(
+            const EndPoint& endpoint);
+
+    uint64_t get_dropped_packets(
+            const EndPoint& endpoint);
+
 private:
     std::map<EndPoint, uint32_t> endpoint_to_client_map_;
     std::map<uint32_t, EndPoint> client_to_endpoint_map_;
+    std::map<EndPoint, uint16_t> endpoint_to_weight_map_;
+    std::map<EndPoint, uint64_t> endpoint_to_dropped_map_;
     std::mutex mtx_;
 };
 
@@ -67,6 +84,11 @@ void SessionManager<EndPoint>::establish_session(
     if (it_client != client_to_endpoint_map_.end())
     {
         endpoint_to_client_map_.erase(it_client->second);
+        endpoint_to_weight_map_.erase(it_client->second);
+        if ((it_client->second < endpoint) || (endpoint < it_client->second))
+        {
+            endpoint_to_dropped_map_.erase(it_client->second);
+        }
         it_client->second = endpoint;
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("session re-established"),
@@ -84,6 +106,8 @@ void SessionManager<EndPoint>::establish_session(
             endpoint);
     }
 
+    endpoint_to_dropped_map_.emplace(endpoint, 0);
+
     if (!has_session_client_key(session_id))
     {
         auto it_endpoint = endpoint_to_client_map_.find(endpoint);
@@ -113,8 +137,10 @@ void SessionManager<EndPoint>::destroy_session(
             it->second,
             endpoint);
         client_to_endpoint_map_.erase(it->second);
+        endpoint_to_weight_map_.erase(it->first);
         endpoint_to_client_map_.erase(it->first);
     }
+    endpoint_to_dropped_map_.erase(endpoint);
 }
 
 template<typename EndPoint>
@@ -153,6 +179,60 @@ bool SessionManager<EndPoint>::get_endpoint(
     return rv;
 }
 
+template<typename EndPoint>
+void SessionManager<EndPoint>::set_output_weight(
+        const EndPoint& endpoint,
+        uint16_t weight)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    endpoint_to_weight_map_[endpoint] = weight;
+}
+
+template<typename EndPoint>
+uint16_t SessionManager<EndPoint>::get_output_weight(
+        const EndPoint& endpoint)
+{
+    uint16_t weight = 1;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = endpoint_to_weight_map_.find(endpoint);
+    if (it != endpoint_to_weight_map_.end())
+    {
+        weight = it->second;
+    }
+
+    return weight;
+}
+
+template<typename EndPoint>
+void SessionManager<EndPoint>::add_dropped_packet(
+        const EndPoint& endpoint)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = endpoint_to_dropped_map_.find(endpoint);
+    if (it != endpoint_to_dropped_map_.end())
+    {
+        ++it->second;
+    }
+}
+
+template<typename EndPoint>
+uint64_t SessionManager<EndPoint>::get_dropped_packets(
+        const EndPoint& endpoint)
+{
+    uint64_t dropped_packets = 0;
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = endpoint_to_dropped_map_.find(endpoint);
+    if (it != endpoint_to_dropped_map_.end())
+    {
+        dropped_packets = it->second;
+    }
+
+    return dropped_packets;
+}
+
 } // namespace uxr
 } // namespace eprosima
 
@@ -17,6 +17,8 @@
 
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
+#include <uxr/agent/message/InputMessage.hpp>
+#include <uxr/agent/utils/BufferPool.hpp>
 
 #include <stdint.h>
 #include <vector>
@@ -35,12 +37,40 @@ typedef enum TCPInputBufferState
 
 } TCPInputBufferState;
 
+/* Messages are received into a pooled buffer, or into the vector if they do not fit in it. */
 struct TCPInputBuffer
 {
+    utils::PooledBuffer pooled_buffer;
     std::vector<uint8_t> buffer;
     uint16_t position;
     TCPInputBufferState state;
     uint16_t msg_size;
+
+    void prepare()
+    {
+        if (msg_size <= INPUT_BUFFER_SIZE)
+        {
+            if (!pooled_buffer)
+            {
+                pooled_buffer = InputMessage::get_buffer_pool().acquire();
+            }
+        }
+        else
+        {
+            buffer.resize(msg_size);
+        }
+    }
+
+    uint8_t* data() { return (msg_size <= INPUT_BUFFER_SIZE) ? pooled_buffer.data() : buffer.data(); }
+
+    /* Builds the received message, handing the pooled buffer over to it. */
+    InputMessage* take_message(
+            size_t len)
+    {
+        return (len <= INPUT_BUFFER_SIZE)
+            ? new InputMessage(std::move(pooled_buffer), len)
+            : new InputMessage(buffer.data(), len);
+    }
 };
 
 struct TCPConnection
@@ -103,11 +103,11 @@ inline uint16_t TCPServerBase<Connection>::read_data(
             }
             case TCP_SIZE_READ:
             {
-                connection.input_buffer.buffer.resize(connection.input_buffer.msg_size);
+                connection.input_buffer.prepare();
                 size_t bytes_received =
                         recv_data(connection,
-                                  connection.input_buffer.buffer.data(),
-                                  connection.input_buffer.buffer.size(),
+                                  connection.input_buffer.data(),
+                                  connection.input_buffer.msg_size,
                                   transport_rc);
                 if (0 < bytes_received)
                 {
@@ -128,8 +128,8 @@ inline uint16_t TCPServerBase<Connection>::read_data(
             {
                 size_t bytes_received =
                         recv_data(connection,
-                                  connection.input_buffer.buffer.data() + connection.input_buffer.position,
-                                  connection.input_buffer.buffer.size() - connection.input_buffer.position,
+                                  connection.input_buffer.data() + connection.input_buffer.position,
+                                  size_t(connection.input_buffer.msg_size - connection.input_buffer.position),
                                   transport_rc);
                 if (0 < bytes_received)
                 {
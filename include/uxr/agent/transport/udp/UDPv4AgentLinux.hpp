@@ -17,6 +17,8 @@
 
 #include <uxr/agent/transport/Server.hpp>
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
+#include <uxr/agent/transport/util/EndPointOwners.hpp>
+#include <uxr/agent/utils/BufferPool.hpp>
 #ifdef UAGENT_DISCOVERY_PROFILE
 #include <uxr/agent/transport/discovery/DiscoveryServerLinux.hpp>
 #endif
@@ -27,7 +29,10 @@
 #include <cstdint>
 #include <cstddef>
 #include <sys/poll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
 #include <unordered_map>
+#include <vector>
 
 namespace eprosima {
 namespace uxr {
@@ -65,16 +70,55 @@ private:
             int timeout,
             TransportRc& transport_rc) final;
 
+    size_t get_receiver_count() const final { return receivers_.size(); }
+
+    bool recv_message_from(
+            size_t receiver_id,
+            InputPacket<IPv4EndPoint>& input_packet,
+            int timeout,
+            TransportRc& transport_rc) final;
+
     bool send_message(
             OutputPacket<IPv4EndPoint> output_packet,
             TransportRc& transport_rc) final;
 
+    size_t send_messages(
+            std::vector<OutputPacket<IPv4EndPoint>>& output_packets,
+            TransportRc& transport_rc) final;
+
     bool handle_error(
             TransportRc transport_rc) final;
 
+    size_t get_owner(
+            const IPv4EndPoint& endpoint);
+
+    void set_owner(
+            const IPv4EndPoint& endpoint,
+            size_t receiver_id);
+
 private:
-    struct pollfd poll_fd_;
-    uint8_t buffer_[SERVER_BUFFER_SIZE];
+    /* Socket bound to the agent port. Datagrams are received in batches and handed out one at a
+     * time. Each one is received into a pooled buffer, which becomes the message, and an overflow
+     * area for those not fitting in it. */
+    struct Receiver
+    {
+        struct pollfd poll_fd;
+        std::vector<utils::PooledBuffer> buffers;
+        std::vector<uint8_t> overflow;
+        std::vector<struct iovec> iovecs;
+        std::vector<struct sockaddr_in> addrs;
+        std::vector<struct mmsghdr> msgs;
+        size_t count;
+        size_t index;
+    };
+
+    std::vector<Receiver> receivers_;
+    /* Socket through which each client is reached, when there are several of them. */
+    util::EndPointOwners<IPv4EndPoint> owners_;
+    std::vector<struct iovec> send_iovecs_;
+    std::vector<struct sockaddr_in> send_addrs_;
+    std::vector<struct mmsghdr> send_msgs_;
+    std::vector<size_t> send_owners_;
     uint16_t agent_port_;
 #ifdef UAGENT_DISCOVERY_PROFILE
     DiscoveryServerLinux<IPv4EndPoint> discovery_server_;
@@ -0,0 +1,162 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TRANSPORT_UTIL_ENDPOINTOWNERS_HPP_
+#define UXR_AGENT_TRANSPORT_UTIL_ENDPOINTOWNERS_HPP_
+
+#include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
+#include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
+
+#include <array>
+#include <list>
+#include <map>
+#include <mutex>
+#include <utility>
+
+namespace eprosima {
+namespace uxr {
+namespace util {
+
+inline size_t get_endpoint_hash(
+        const IPv4EndPoint& endpoint)
+{
+    return (size_t(endpoint.get_addr()) * 31u) ^ endpoint.get_port();
+}
+
+inline size_t get_endpoint_hash(
+        const IPv6EndPoint& endpoint)
+{
+    size_t hash = endpoint.get_port();
+    for (uint8_t byte : endpoint.get_addr())
+    {
+        hash = (hash * 31u) ^ byte;
+    }
+    return hash;
+}
+
+/**
+ * Receiver through which each endpoint is reached, when a transport listens on several sockets.
+ * Endpoints are spread over independently locked stripes, so that receivers and senders only
+ * contend when they handle endpoints of the same stripe. Each stripe keeps its endpoints in
+ * least recently received order, and forgets the oldest one when it is full.
+ */
+template<typename EndPoint>
+class EndPointOwners
+{
+public:
+    static constexpr size_t STRIPES = 64;
+
+    explicit EndPointOwners(
+            size_t max_endpoints)
+        : max_stripe_size_((max_endpoints + STRIPES - 1) / STRIPES)
+        , stripes_()
+    {}
+
+    EndPointOwners(EndPointOwners&&) = delete;
+    EndPointOwners(const EndPointOwners&) = delete;
+    EndPointOwners& operator=(EndPointOwners&&) = delete;
+    EndPointOwners& operator=(const EndPointOwners&) = delete;
+
+    /**
+     * @brief Gets the receiver of an endpoint.
+     * @return  The receiver, or the first one if the endpoint is unknown.
+     */
+    size_t get(
+            const EndPoint& endpoint)
+    {
+        size_t receiver_id = 0;
+        Stripe& stripe = get_stripe(endpoint);
+        std::lock_guard<std::mutex> lock(stripe.mtx);
+        auto it = stripe.index.find(endpoint);
+        if (stripe.index.end() != it)
+        {
+            receiver_id = it->second->second;
+        }
+        return receiver_id;
+    }
+
+    /**
+     * @brief Records the receiver through which a datagram from an endpoint has arrived.
+     */
+    void set(
+            const EndPoint& endpoint,
+            size_t receiver_id)
+    {
+        Stripe& stripe = get_stripe(endpoint);
+        std::lock_guard<std::mutex> lock(stripe.mtx);
+        auto it = stripe.index.find(endpoint);
+        if (stripe.index.end() != it)
+        {
+            /* Usually the endpoint keeps its receiver, and it is already the most recent one. */
+            if (it->second->second != receiver_id)
+            {
+                it->second->second = receiver_id;
+            }
+            if (stripe.entries.begin() != it->second)
+            {
+                stripe.entries.splice(stripe.entries.begin(), stripe.entries, it->second);
+            }
+        }
+        else
+        {
+            if (max_stripe_size_ <= stripe.entries.size())
+            {
+                stripe.index.erase(stripe.entries.back().first);
+                stripe.entries.pop_back();
+            }
+            stripe.entries.emplace_front(endpoint, receiver_id);
+            stripe.index.emplace(endpoint, stripe.entries.begin());
+        }
+    }
+
+    void clear()
+    {
+        for (Stripe& stripe : stripes_)
+        {
+            std::lock_guard<std::mutex> lock(stripe.mtx);
+            stripe.index.clear();
+            stripe.entries.clear();
+        }
+    }
+
+private:
+    typedef std::list<std::pair<EndPoint, size_t>> EntryList;
+
+    struct Stripe
+    {
+        std::mutex mtx;
+        /* Most recently received first. */
+        EntryList entries;
+        std::map<EndPoint, typename EntryList::iterator> index;
+    };
+
+    Stripe& get_stripe(
+            const EndPoint& endpoint)
+    {
+        return stripes_[get_endpoint_hash(endpoint) % STRIPES];
+    }
+
+private:
+    const size_t max_stripe_size_;
+    std::array<Stripe, STRIPES> stripes_;
+};
+
+template<typename EndPoint>
+constexpr size_t EndPointOwners<EndPoint>::STRIPES;
+
+} // namespace util
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TRANSPORT_UTIL_ENDPOINTOWNERS_HPP_
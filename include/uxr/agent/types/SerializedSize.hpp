@@ -0,0 +1,76 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_TYPES_SERIALIZED_SIZE_HPP_
+#define UXR_AGENT_TYPES_SERIALIZED_SIZE_HPP_
+
+#include <uxr/agent/types/XRCETypes.hpp>
+
+#include <cstddef>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Serialized size of a submessage payload, as given by getCdrSerializedSize() with no
+ * initial alignment. Fixed-size payloads sent on every stream are resolved at compile time,
+ * and DATA payloads without walking the sample.
+ */
+template<class T>
+struct SerializedSize
+{
+    static size_t get(const T& data) { return data.getCdrSerializedSize(); }
+};
+
+template<>
+struct SerializedSize<dds::xrce::HEARTBEAT_Payload>
+{
+    /* first_unacked_seq_nr, last_unacked_seq_nr and stream_id. */
+    static constexpr size_t get(const dds::xrce::HEARTBEAT_Payload&) { return 2 + 2 + 1; }
+};
+
+template<>
+struct SerializedSize<dds::xrce::ACKNACK_Payload>
+{
+    /* first_unacked_seq_num, nack_bitmap and stream_id. */
+    static constexpr size_t get(const dds::xrce::ACKNACK_Payload&) { return 2 + 2 + 1; }
+};
+
+template<>
+struct SerializedSize<dds::xrce::STATUS_Payload>
+{
+    /* request_id, object_id, status and implementation_status. */
+    static constexpr size_t get(const dds::xrce::STATUS_Payload&) { return 2 + 2 + 1 + 1; }
+};
+
+template<>
+struct SerializedSize<dds::xrce::DATA_Payload_Data>
+{
+    /* request_id, object_id and the raw sample. */
+    static size_t get(const dds::xrce::DATA_Payload_Data& data)
+    {
+        return 2 + 2 + data.data().serialized_data().size();
+    }
+};
+
+template<class T>
+inline size_t get_serialized_size(const T& data)
+{
+    return SerializedSize<T>::get(data);
+}
+
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_TYPES_SERIALIZED_SIZE_HPP_
@@ -17,12 +17,25 @@
 
 #include <fastrtps/TopicDataType.h>
 
+#include <cstddef>
+#include <cstdint>
 #include <vector>
 
 using namespace eprosima::fastrtps;
 namespace eprosima {
 namespace uxr {
 
+/**
+ * Sample written through the DataWriters, which points to the serialized data wherever it lies
+ * (usually the buffer of the client's message) so that it is copied just once, into the payload.
+ * The samples taken from the DataReaders are std::vector<unsigned char>, see createData().
+ */
+struct SerializedSample
+{
+    const uint8_t* data;
+    size_t size;
+};
+
 class TopicPubSubType: public TopicDataType
 {
 public:
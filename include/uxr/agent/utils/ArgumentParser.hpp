@@ -44,6 +44,22 @@
 #define DEFAULT_VERBOSE_LEVEL   4
 #define DEFAULT_DISCOVERY_PORT  7400
 #define DEFAULT_BAUDRATE_LEVEL  "115200"
+#define DEFAULT_PROCESSING_THREADS  1
+#define DEFAULT_RECEIVER_THREADS    1
+#define DEFAULT_SCHEDULER_KIND  "fcfs"
+#define DEFAULT_OVERFLOW_POLICY "drop-oldest"
+#define DEFAULT_EXECUTION_MODE  "threaded"
+#define DEFAULT_THREAD_SETTINGS ""
+#define DEFAULT_BATCH_SIZE      1
+#define DEFAULT_AGGREGATION_BUDGET  0
+#define DEFAULT_ACKNACK_MESSAGES    1
+#define DEFAULT_ACKNACK_DELAY       0
+#define DEFAULT_RELIABLE_DEPTH      RELIABLE_STREAM_DEPTH
+#define DEFAULT_BEST_EFFORT_DEPTH   BEST_EFFORT_STREAM_DEPTH
+#define DEFAULT_MAX_STREAM_DEPTH    DEFAULT_MAX_CLIENT_STREAM_DEPTH
+#define DEFAULT_HEARTBEAT_PERIOD    HEARTBEAT_PERIOD
+#define DEFAULT_QUEUE_SIZE          SERVER_QUEUE_MAX_SIZE
+#define DEFAULT_CLIENT_DEAD_TIME    CLIENT_DEAD_TIME.count()
 
 namespace eprosima {
 namespace uxr {
@@ -86,6 +102,26 @@ TransportKind check_transport(
 
 Middleware::Kind get_mw_kind(
         const std::string& kind);
+
+SchedulerKind get_scheduler_kind(
+        const std::string& kind);
+
+OverflowPolicy get_overflow_policy(
+        const std::string& policy);
+
+ExecutionMode get_execution_mode(
+        const std::string& mode);
+
+/**
+ * @brief Parses the thread settings given as colon-separated <kind>=<value> entries, where the kind is
+ *        recv, proc, send, hb, rd, disc, aux or all, e.g. "recv=2:proc=3-5,7" for the CPU affinity
+ *        and "recv=80:proc=70" for the SCHED_FIFO priority.
+ * @return  true if both strings are valid.
+ */
+UXR_AGENT_EXPORT bool get_thread_settings(
+        const std::string& affinity,
+        const std::string& priority,
+        std::array<ThreadSettings, THREAD_KIND_COUNT>& settings);
 } // namespace utils
 
 using dummy_type = uint8_t;
@@ -467,6 +503,31 @@ public:
 #ifdef UAGENT_P2P_PROFILE
         , p2p_("-P", "--p2p")
 #endif
+        , processing_threads_("-t", "--processing-threads", static_cast<uint16_t>(DEFAULT_PROCESSING_THREADS), {}, false)
+        , receiver_threads_("-R", "--receiver-threads", static_cast<uint16_t>(DEFAULT_RECEIVER_THREADS), {}, false)
+        , input_scheduler_("-i", "--input-scheduler", std::string(DEFAULT_SCHEDULER_KIND),
+            {"fcfs", "ring", "drr"}, false)
+        , output_scheduler_("-o", "--output-scheduler", std::string(DEFAULT_SCHEDULER_KIND),
+            {"fcfs", "ring", "priority", "drr"}, false)
+        , input_overflow_("-I", "--input-overflow", std::string(DEFAULT_OVERFLOW_POLICY),
+            {"drop-oldest", "drop-newest", "drop-best-effort", "reject-by-class", "block"}, false)
+        , output_overflow_("-O", "--output-overflow", std::string(DEFAULT_OVERFLOW_POLICY),
+            {"drop-oldest", "drop-newest", "drop-best-effort", "reject-by-class", "block"}, false)
+        , execution_mode_("-e", "--execution-mode", std::string(DEFAULT_EXECUTION_MODE),
+            {"threaded", "event-loop"}, false)
+        , thread_affinity_("-a", "--thread-affinity", std::string(DEFAULT_THREAD_SETTINGS), {}, false)
+        , thread_priority_("-s", "--thread-priority", std::string(DEFAULT_THREAD_SETTINGS), {}, false)
+        , recv_batch_("-B", "--recv-batch", static_cast<uint16_t>(DEFAULT_BATCH_SIZE), {}, false)
+        , send_batch_("-S", "--send-batch", static_cast<uint16_t>(DEFAULT_BATCH_SIZE), {}, false)
+        , aggregation_budget_("-A", "--aggregation-budget", static_cast<uint16_t>(DEFAULT_AGGREGATION_BUDGET), {}, false)
+        , acknack_messages_("-N", "--acknack-messages", static_cast<uint16_t>(DEFAULT_ACKNACK_MESSAGES), {}, false)
+        , acknack_delay_("-K", "--acknack-delay", static_cast<uint16_t>(DEFAULT_ACKNACK_DELAY), {}, false)
+        , reliable_depth_("-W", "--reliable-depth", static_cast<uint16_t>(DEFAULT_RELIABLE_DEPTH), {}, false)
+        , best_effort_depth_("-E", "--best-effort-depth", static_cast<uint16_t>(DEFAULT_BEST_EFFORT_DEPTH), {}, false)
+        , max_stream_depth_("-X", "--max-stream-depth", static_cast<uint16_t>(DEFAULT_MAX_STREAM_DEPTH), {}, false)
+        , heartbeat_period_("-H", "--heartbeat-period", static_cast<uint16_t>(DEFAULT_HEARTBEAT_PERIOD), {}, false)
+        , queue_size_("-Q", "--queue-size", static_cast<uint32_t>(DEFAULT_QUEUE_SIZE), {}, false)
+        , client_dead_time_("-T", "--client-dead-time", static_cast<uint32_t>(DEFAULT_CLIENT_DEAD_TIME), {}, false)
     {
     }
 
@@ -534,9 +595,163 @@ public:
             return result;
         }
 #endif
+        if (ParseResult::INVALID == processing_threads_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == receiver_threads_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == input_scheduler_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == output_scheduler_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == input_overflow_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == output_overflow_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == execution_mode_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if ((ParseResult::INVALID == thread_affinity_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == thread_priority_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
+        std::array<ThreadSettings, THREAD_KIND_COUNT> thread_settings;
+        if (!utils::get_thread_settings(thread_affinity_.value(), thread_priority_.value(), thread_settings))
+        {
+            std::cerr << "Error: invalid thread settings, expected <kind>=<value>[:<kind>=<value>...] ";
+            std::cerr << "with kind in {recv, proc, send, hb, rd, disc, aux, all}." << std::endl;
+            result.first = false;
+            return result;
+        }
+        if ((ParseResult::INVALID == recv_batch_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == send_batch_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
+        if (ParseResult::INVALID == aggregation_budget_.parse_argument(argc, argv))
+        {
+            result.first = false;
+            return result;
+        }
+        if ((ParseResult::INVALID == acknack_messages_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == acknack_delay_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
+        if ((ParseResult::INVALID == reliable_depth_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == best_effort_depth_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == max_stream_depth_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
+        if ((ParseResult::INVALID == heartbeat_period_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == queue_size_.parse_argument(argc, argv)) ||
+            (ParseResult::INVALID == client_dead_time_.parse_argument(argc, argv)))
+        {
+            result.first = false;
+            return result;
+        }
         return result;
     }
 
+    bool apply_settings(
+            std::unique_ptr<AgentType>& server)
+    {
+        bool rv = true;
+        if (processing_threads_.found())
+        {
+            rv &= server->set_processing_threads(processing_threads_.value());
+        }
+        if (receiver_threads_.found())
+        {
+            rv &= server->set_receiver_threads(receiver_threads_.value());
+        }
+        if (input_scheduler_.found() || output_scheduler_.found())
+        {
+            rv &= server->set_scheduler_kind(
+                utils::get_scheduler_kind(input_scheduler_.value()),
+                utils::get_scheduler_kind(output_scheduler_.value()));
+        }
+        if (input_overflow_.found() || output_overflow_.found())
+        {
+            rv &= server->set_overflow_policy(
+                utils::get_overflow_policy(input_overflow_.value()),
+                utils::get_overflow_policy(output_overflow_.value()));
+        }
+        if (execution_mode_.found())
+        {
+            rv &= server->set_execution_mode(utils::get_execution_mode(execution_mode_.value()));
+        }
+        if (thread_affinity_.found() || thread_priority_.found())
+        {
+            std::array<ThreadSettings, THREAD_KIND_COUNT> thread_settings;
+            rv &= utils::get_thread_settings(thread_affinity_.value(), thread_priority_.value(), thread_settings);
+            for (size_t i = 0; i < THREAD_KIND_COUNT; ++i)
+            {
+                rv &= server->set_thread_settings(
+                    ThreadKind(i), thread_settings[i].cpus, thread_settings[i].priority);
+            }
+        }
+        if (recv_batch_.found() || send_batch_.found())
+        {
+            rv &= server->set_batch_size(recv_batch_.value(), send_batch_.value());
+        }
+        if (aggregation_budget_.found())
+        {
+            rv &= server->set_aggregation_budget(std::chrono::milliseconds(aggregation_budget_.value()));
+        }
+        if (acknack_messages_.found() || acknack_delay_.found())
+        {
+            rv &= server->set_acknack_coalescing(
+                acknack_messages_.value(), std::chrono::milliseconds(acknack_delay_.value()));
+        }
+        if (reliable_depth_.found() || best_effort_depth_.found())
+        {
+            rv &= server->set_stream_depths(reliable_depth_.value(), best_effort_depth_.value());
+        }
+        if (max_stream_depth_.found())
+        {
+            rv &= server->set_max_stream_depth(max_stream_depth_.value());
+        }
+        if (heartbeat_period_.found())
+        {
+            rv &= server->set_heartbeat_period(std::chrono::milliseconds(heartbeat_period_.value()));
+        }
+        if (queue_size_.found())
+        {
+            rv &= server->set_queue_size(queue_size_.value());
+        }
+        if (client_dead_time_.found())
+        {
+            rv &= server->set_client_dead_time(std::chrono::milliseconds(client_dead_time_.value()));
+        }
+        return rv;
+    }
+
     void apply_actions(
             std::unique_ptr<AgentType>& server)
     {
@@ -575,6 +790,26 @@ public:
 #ifdef UAGENT_P2P_PROFILE
         ss << "    " << p2p_.get_help() << std::endl;
 #endif
+        ss << "    " << processing_threads_.get_help() << std::endl;
+        ss << "    " << receiver_threads_.get_help() << std::endl;
+        ss << "    " << input_scheduler_.get_help() << std::endl;
+        ss << "    " << output_scheduler_.get_help() << std::endl;
+        ss << "    " << input_overflow_.get_help() << std::endl;
+        ss << "    " << output_overflow_.get_help() << std::endl;
+        ss << "    " << execution_mode_.get_help() << std::endl;
+        ss << "    " << thread_affinity_.get_help() << std::endl;
+        ss << "    " << thread_priority_.get_help() << std::endl;
+        ss << "    " << recv_batch_.get_help() << std::endl;
+        ss << "    " << send_batch_.get_help() << std::endl;
+        ss << "    " << aggregation_budget_.get_help() << std::endl;
+        ss << "    " << acknack_messages_.get_help() << " More than one requires -K/--acknack-delay." << std::endl;
+        ss << "    " << acknack_delay_.get_help() << std::endl;
+        ss << "    " << reliable_depth_.get_help() << std::endl;
+        ss << "    " << best_effort_depth_.get_help() << std::endl;
+        ss << "    " << max_stream_depth_.get_help() << " Deepest streams a client may ask for." << std::endl;
+        ss << "    " << heartbeat_period_.get_help() << std::endl;
+        ss << "    " << queue_size_.get_help() << std::endl;
+        ss << "    " << client_dead_time_.get_help() << std::endl;
         return ss.str();
     }
 
@@ -589,6 +824,26 @@ private:
 #ifdef UAGENT_P2P_PROFILE
     Argument<uint16_t> p2p_;
 #endif
+    Argument<uint16_t> processing_threads_;
+    Argument<uint16_t> receiver_threads_;
+    Argument<std::string> input_scheduler_;
+    Argument<std::string> output_scheduler_;
+    Argument<std::string> input_overflow_;
+    Argument<std::string> output_overflow_;
+    Argument<std::string> execution_mode_;
+    Argument<std::string> thread_affinity_;
+    Argument<std::string> thread_priority_;
+    Argument<uint16_t> recv_batch_;
+    Argument<uint16_t> send_batch_;
+    Argument<uint16_t> aggregation_budget_;
+    Argument<uint16_t> acknack_messages_;
+    Argument<uint16_t> acknack_delay_;
+    Argument<uint16_t> reliable_depth_;
+    Argument<uint16_t> best_effort_depth_;
+    Argument<uint16_t> max_stream_depth_;
+    Argument<uint16_t> heartbeat_period_;
+    Argument<uint32_t> queue_size_;
+    Argument<uint32_t> client_dead_time_;
 };
 
 /*************************************************************************************************
@@ -786,7 +1041,7 @@ public:
     bool launch_ipvx_agent()
     {
         agent_server_.reset(new AgentType(ip_args_.port(), utils::get_mw_kind(common_args_.middleware())));
-        if (agent_server_->start())
+        if (common_args_.apply_settings(agent_server_) && agent_server_->start())
         {
             common_args_.apply_actions(agent_server_);
             return true;
@@ -842,7 +1097,7 @@ public:
         agent_server_.reset(new TermiosAgent(
             serial_args_.dev().c_str(),  O_RDWR | O_NOCTTY, attr, 0, utils::get_mw_kind(common_args_.middleware())));
 
-        if (agent_server_->start())
+        if (common_args_.apply_settings(agent_server_) && agent_server_->start())
         {
             common_args_.apply_actions(agent_server_);
             return true;
@@ -858,7 +1113,7 @@ public:
     {
         agent_server_.reset(new PseudoTerminalAgent(
             O_RDWR | O_NOCTTY, pseudoterminal_args_.baud_rate().c_str(), 0, utils::get_mw_kind(common_args_.middleware())));
-        if (agent_server_->start())
+        if (common_args_.apply_settings(agent_server_) && agent_server_->start())
         {
             common_args_.apply_actions(agent_server_);
             return true;
@@ -0,0 +1,255 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_BUFFERPOOL_HPP_
+#define UXR_AGENT_UTILS_BUFFERPOOL_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+class BufferPool;
+
+/**
+ * Fixed-size buffer taken from a BufferPool and given back to it on destruction.
+ * It may be moved but not copied.
+ */
+class PooledBuffer
+{
+public:
+    PooledBuffer()
+        : pool_{nullptr}
+        , data_{nullptr}
+    {}
+
+    PooledBuffer(PooledBuffer&& other) noexcept
+        : pool_{other.pool_}
+        , data_{other.data_}
+    {
+        other.pool_ = nullptr;
+        other.data_ = nullptr;
+    }
+
+    PooledBuffer& operator=(PooledBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            reset();
+            pool_ = other.pool_;
+            data_ = other.data_;
+            other.pool_ = nullptr;
+            other.data_ = nullptr;
+        }
+        return *this;
+    }
+
+    PooledBuffer(const PooledBuffer&) = delete;
+    PooledBuffer& operator=(const PooledBuffer&) = delete;
+
+    ~PooledBuffer() { reset(); }
+
+    uint8_t* data() const { return data_; }
+
+    size_t size() const;
+
+    explicit operator bool() const { return nullptr != data_; }
+
+    /**
+     * @brief Gives the buffer back to its pool.
+     */
+    void reset();
+
+private:
+    friend class BufferPool;
+
+    PooledBuffer(
+            BufferPool* pool,
+            uint8_t* data)
+        : pool_{pool}
+        , data_{data}
+    {}
+
+private:
+    BufferPool* pool_;
+    uint8_t* data_;
+};
+
+/**
+ * Thread-safe pool of fixed-size buffers. Released buffers are kept for reuse up to a maximum,
+ * so that in steady state acquiring a buffer does not allocate. Newly allocated buffers are
+ * zero-filled, reused ones keep their previous contents.
+ * Free buffers are spread over independently locked shards, each thread using its own one first,
+ * so that threads only contend when a shard runs empty or full.
+ * The pool shall outlive the buffers taken from it.
+ */
+class BufferPool
+{
+public:
+    static constexpr size_t SHARDS = 8;
+
+    BufferPool(
+            size_t buffer_size,
+            size_t max_free_buffers)
+        : buffer_size_{buffer_size}
+        , shards_()
+        , allocations_{0}
+        , acquisitions_{0}
+    {
+        for (size_t i = 0; i < SHARDS; ++i)
+        {
+            shards_[i].max_size = (max_free_buffers / SHARDS) + ((i < (max_free_buffers % SHARDS)) ? 1 : 0);
+        }
+    }
+
+    ~BufferPool()
+    {
+        for (Shard& shard : shards_)
+        {
+            for (uint8_t* data : shard.free_buffers)
+            {
+                delete[] data;
+            }
+        }
+    }
+
+    BufferPool(BufferPool&&) = delete;
+    BufferPool(const BufferPool&) = delete;
+    BufferPool& operator=(BufferPool&&) = delete;
+    BufferPool& operator=(const BufferPool&) = delete;
+
+    /**
+     * @brief Takes a buffer from the pool, allocating it if there is no free one.
+     * @return  The buffer, given back to the pool on destruction.
+     */
+    PooledBuffer acquire();
+
+    /**
+     * @brief Takes a raw buffer from the pool, to be given back through deallocate().
+     * @return  The buffer, of get_buffer_size() bytes.
+     */
+    uint8_t* allocate();
+
+    void deallocate(
+            uint8_t* data);
+
+    size_t get_buffer_size() const { return buffer_size_; }
+
+    /**
+     * @brief Accounts for a heap allocation done on behalf of the pool by one of its users,
+     *        e.g. for an object larger than the buffers.
+     */
+    void add_allocation() { allocations_.fetch_add(1, std::memory_order_relaxed); }
+
+    /** Number of buffers allocated from the heap, which stops growing in steady state. */
+    uint64_t get_allocations() const { return allocations_.load(std::memory_order_relaxed); }
+
+    uint64_t get_acquisitions() const { return acquisitions_.load(std::memory_order_relaxed); }
+
+private:
+    struct Shard
+    {
+        std::mutex mtx;
+        std::vector<uint8_t*> free_buffers;
+        size_t max_size;
+    };
+
+    /* Shards are handed out to threads in turn, so that a few threads seldom share one. */
+    static size_t get_shard_index()
+    {
+        static std::atomic<size_t> next_index{0};
+        thread_local size_t index = next_index.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return index;
+    }
+
+private:
+    const size_t buffer_size_;
+    std::array<Shard, SHARDS> shards_;
+    std::atomic<uint64_t> allocations_;
+    std::atomic<uint64_t> acquisitions_;
+};
+
+inline size_t PooledBuffer::size() const
+{
+    return (nullptr != pool_) ? pool_->get_buffer_size() : 0;
+}
+
+inline void PooledBuffer::reset()
+{
+    if (nullptr != data_)
+    {
+        pool_->deallocate(data_);
+        pool_ = nullptr;
+        data_ = nullptr;
+    }
+}
+
+inline PooledBuffer BufferPool::acquire()
+{
+    return PooledBuffer(this, allocate());
+}
+
+inline uint8_t* BufferPool::allocate()
+{
+    uint8_t* data = nullptr;
+    acquisitions_.fetch_add(1, std::memory_order_relaxed);
+    /* The shard of the thread is tried first, then the others before allocating. */
+    const size_t first_index = get_shard_index();
+    for (size_t i = 0; (nullptr == data) && (i < SHARDS); ++i)
+    {
+        Shard& shard = shards_[(first_index + i) % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if (!shard.free_buffers.empty())
+        {
+            data = shard.free_buffers.back();
+            shard.free_buffers.pop_back();
+        }
+    }
+    if (nullptr == data)
+    {
+        data = new uint8_t[buffer_size_]{0};
+        allocations_.fetch_add(1, std::memory_order_relaxed);
+    }
+    return data;
+}
+
+inline void BufferPool::deallocate(
+        uint8_t* data)
+{
+    /* A full shard spills over the others, so that up to max_free_buffers are kept overall. */
+    const size_t first_index = get_shard_index();
+    for (size_t i = 0; (nullptr != data) && (i < SHARDS); ++i)
+    {
+        Shard& shard = shards_[(first_index + i) % SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        if (shard.free_buffers.size() < shard.max_size)
+        {
+            shard.free_buffers.push_back(data);
+            data = nullptr;
+        }
+    }
+    delete[] data;
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_BUFFERPOOL_HPP_
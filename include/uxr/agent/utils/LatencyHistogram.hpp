@@ -0,0 +1,149 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_LATENCYHISTOGRAM_HPP_
+#define UXR_AGENT_UTILS_LATENCYHISTOGRAM_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Lock-free latency histogram with logarithmic buckets: each power of two is split in 8 linear
+ * sub-buckets, so percentiles are reported with an error below 12.5%.
+ * Samples may be recorded concurrently from several threads.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram()
+        : count_{0}
+    {
+        reset();
+    }
+
+    LatencyHistogram(LatencyHistogram&&) = delete;
+    LatencyHistogram(const LatencyHistogram&) = delete;
+    LatencyHistogram& operator=(LatencyHistogram&&) = delete;
+    LatencyHistogram& operator=(const LatencyHistogram&) = delete;
+
+    void record(
+            std::chrono::nanoseconds latency);
+
+    /**
+     * @brief Returns the latency below which the given percentage of the samples fall.
+     * @param percentile    The percentile, from 0 to 100.
+     * @return  The upper bound of the bucket holding the percentile, zero if there are no samples.
+     */
+    std::chrono::nanoseconds get_percentile(
+            double percentile) const;
+
+    uint64_t get_count() const { return count_.load(std::memory_order_relaxed); }
+
+    void reset();
+
+private:
+    static size_t bucket_index(
+            uint64_t value);
+
+    static uint64_t bucket_upper_bound(
+            size_t index);
+
+private:
+    static constexpr size_t SUB_BUCKET_BITS = 3;
+    static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+    static constexpr size_t BUCKETS = 64 * SUB_BUCKETS;
+
+    std::array<std::atomic<uint64_t>, BUCKETS> buckets_;
+    std::atomic<uint64_t> count_;
+};
+
+inline void LatencyHistogram::record(
+        std::chrono::nanoseconds latency)
+{
+    const uint64_t value = (0 < latency.count()) ? uint64_t(latency.count()) : 0;
+    buckets_[bucket_index(value)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+}
+
+inline std::chrono::nanoseconds LatencyHistogram::get_percentile(
+        double percentile) const
+{
+    const uint64_t count = get_count();
+    if (0 == count)
+    {
+        return std::chrono::nanoseconds(0);
+    }
+
+    percentile = (percentile < 0.0) ? 0.0 : ((100.0 < percentile) ? 100.0 : percentile);
+    uint64_t target = uint64_t((percentile * double(count)) / 100.0 + 0.5);
+    target = (0 == target) ? 1 : target;
+
+    uint64_t accumulated = 0;
+    size_t index = 0;
+    for (; index < BUCKETS - 1; ++index)
+    {
+        accumulated += buckets_[index].load(std::memory_order_relaxed);
+        if (target <= accumulated)
+        {
+            break;
+        }
+    }
+    return std::chrono::nanoseconds(int64_t(bucket_upper_bound(index)));
+}
+
+inline void LatencyHistogram::reset()
+{
+    for (auto& bucket : buckets_)
+    {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    count_.store(0, std::memory_order_relaxed);
+}
+
+inline size_t LatencyHistogram::bucket_index(
+        uint64_t value)
+{
+    size_t shift = 0;
+    while ((SUB_BUCKETS << 1) <= value)
+    {
+        value >>= 1;
+        ++shift;
+    }
+    return (shift * SUB_BUCKETS) + size_t(value);
+}
+
+inline uint64_t LatencyHistogram::bucket_upper_bound(
+        size_t index)
+{
+    if (index < (SUB_BUCKETS << 1))
+    {
+        return uint64_t(index);
+    }
+    const size_t shift = (index / SUB_BUCKETS) - 1;
+    const uint64_t sub_bucket = uint64_t(index % SUB_BUCKETS) + SUB_BUCKETS;
+    return ((sub_bucket + 1) << shift) - 1;
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_LATENCYHISTOGRAM_HPP_
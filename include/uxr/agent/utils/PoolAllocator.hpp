@@ -0,0 +1,101 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_POOLALLOCATOR_HPP_
+#define UXR_AGENT_UTILS_POOLALLOCATOR_HPP_
+
+#include <uxr/agent/utils/BufferPool.hpp>
+
+#include <cstddef>
+#include <new>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Standard allocator taking single objects from a BufferPool, e.g. to let std::allocate_shared
+ * place an object and its control block in a pooled buffer.
+ * Arrays and objects larger than the buffers of the pool are allocated from the heap,
+ * and accounted for in the allocations of the pool.
+ */
+template<class T>
+class PoolAllocator
+{
+public:
+    typedef T value_type;
+
+    explicit PoolAllocator(
+            BufferPool& pool) noexcept
+        : pool_{&pool}
+    {}
+
+    template<class U>
+    PoolAllocator(
+            const PoolAllocator<U>& other) noexcept
+        : pool_{other.pool_}
+    {}
+
+    T* allocate(
+            size_t n)
+    {
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types are not supported.");
+        if (1 == n && sizeof(T) <= pool_->get_buffer_size())
+        {
+            return reinterpret_cast<T*>(pool_->allocate());
+        }
+        pool_->add_allocation();
+        return static_cast<T*>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(
+            T* p,
+            size_t n) noexcept
+    {
+        if (1 == n && sizeof(T) <= pool_->get_buffer_size())
+        {
+            pool_->deallocate(reinterpret_cast<uint8_t*>(p));
+        }
+        else
+        {
+            ::operator delete(p);
+        }
+    }
+
+    template<class U>
+    bool operator==(
+            const PoolAllocator<U>& other) const noexcept
+    {
+        return pool_ == other.pool_;
+    }
+
+    template<class U>
+    bool operator!=(
+            const PoolAllocator<U>& other) const noexcept
+    {
+        return pool_ != other.pool_;
+    }
+
+private:
+    template<class U>
+    friend class PoolAllocator;
+
+    BufferPool* pool_;
+};
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_POOLALLOCATOR_HPP_
@@ -0,0 +1,85 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_THREADSETTINGS_HPP_
+#define UXR_AGENT_UTILS_THREADSETTINGS_HPP_
+
+#include <uxr/agent/visibility.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+
+/**
+ * Roles of the threads spawned by the agent, each one with its own CPU affinity and scheduling.
+ * Threads are named after their role: uxr-recv (uxr-loop in the event-loop mode), uxr-proc,
+ * uxr-send, uxr-hb, uxr-rd-<client key>, uxr-disc, and uxr-err, uxr-tcp or uxr-p2p for the
+ * auxiliary ones.
+ */
+enum class ThreadKind : uint8_t
+{
+    RECEIVER,
+    PROCESSING,
+    SENDER,
+    HEARTBEAT,
+    READER,
+    DISCOVERY,
+    AUXILIARY
+};
+
+const size_t THREAD_KIND_COUNT = 7;
+
+struct ThreadSettings
+{
+    /** CPUs on which the threads may run, any of them if empty. */
+    std::vector<uint16_t> cpus;
+    /** SCHED_FIFO priority, from 1 to 99, or 0 to keep the default scheduling policy. */
+    uint8_t priority;
+};
+
+namespace utils {
+
+/**
+ * @brief Sets the settings of the threads of the given kind, process-wide.
+ *        They are applied to the threads started afterwards.
+ * @param kind      The thread kind.
+ * @param settings  The CPU affinity and priority.
+ * @return  true in case of success and false in other case (invalid priority).
+ */
+UXR_AGENT_EXPORT bool set_thread_settings(
+        ThreadKind kind,
+        const ThreadSettings& settings);
+
+UXR_AGENT_EXPORT ThreadSettings get_thread_settings(
+        ThreadKind kind);
+
+/**
+ * @brief Names the calling thread and applies the settings of its kind.
+ *        Failures (e.g. lack of privileges for SCHED_FIFO) are logged and the thread keeps running.
+ * @param kind  The thread kind.
+ * @param name  The thread name, truncated to 15 characters.
+ * @return  true in case of success and false in other case.
+ */
+UXR_AGENT_EXPORT bool configure_current_thread(
+        ThreadKind kind,
+        const std::string& name);
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_THREADSETTINGS_HPP_
@@ -0,0 +1,225 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef UXR_AGENT_UTILS_TIMERWHEEL_HPP_
+#define UXR_AGENT_UTILS_TIMERWHEEL_HPP_
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <unordered_map>
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+/**
+ * Hierarchical timing wheel. Timers are identified by a key and expire at an absolute tick.
+ * Each level has 64 slots spanning 64 times the ticks of the previous one; a timer is placed in
+ * the finest level able to hold it and cascades down as time advances, so arming, disarming and
+ * expiring cost O(1) regardless of the number of armed timers.
+ * Disarmed timers are not searched for, they are discarded when their slot is visited.
+ * Deadlines beyond the span of the wheel (64^4 ticks) are clamped to it.
+ * This class is not thread-safe.
+ */
+class TimerWheel
+{
+public:
+    explicit TimerWheel(
+            uint64_t now = 0)
+        : wheels_()
+        , armed_()
+        , current_{now}
+    {}
+
+    TimerWheel(TimerWheel&&) = delete;
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(TimerWheel&&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    /**
+     * @brief Arms a timer, unless it is already armed.
+     *        Past deadlines expire on the next tick.
+     * @param key       The timer identifier.
+     * @param deadline  The absolute tick at which the timer expires.
+     * @return true if the timer was armed, false if it was already armed.
+     */
+    bool arm(
+            uint64_t key,
+            uint64_t deadline);
+
+    /**
+     * @brief Disarms a timer.
+     * @param key   The timer identifier.
+     * @return true if the timer was armed.
+     */
+    bool disarm(
+            uint64_t key);
+
+    bool is_armed(
+            uint64_t key) const { return armed_.end() != armed_.find(key); }
+
+    size_t size() const { return armed_.size(); }
+
+    uint64_t now() const { return current_; }
+
+    /**
+     * @brief Advances the wheel up to the given tick, disarming the expired timers.
+     * @param now           The current tick.
+     * @param on_expired    Callable invoked with the key of each expired timer, in deadline order.
+     *                      It may arm timers again.
+     */
+    template<typename F>
+    void advance(
+            uint64_t now,
+            F&& on_expired);
+
+private:
+    struct Timer
+    {
+        uint64_t key;
+        uint64_t deadline;
+    };
+
+    void insert(
+            const Timer& timer);
+
+    void cascade(
+            size_t level);
+
+    void clear();
+
+private:
+    static constexpr size_t SLOT_BITS = 6;
+    static constexpr size_t SLOTS = size_t(1) << SLOT_BITS;
+    static constexpr size_t LEVELS = 4;
+    static constexpr uint64_t SPAN = uint64_t(1) << (SLOT_BITS * LEVELS);
+
+    std::array<std::array<std::vector<Timer>, SLOTS>, LEVELS> wheels_;
+    std::unordered_map<uint64_t, uint64_t> armed_;
+    uint64_t current_;
+};
+
+inline bool TimerWheel::arm(
+        uint64_t key,
+        uint64_t deadline)
+{
+    bool rv = false;
+    if (armed_.end() == armed_.find(key))
+    {
+        if (deadline <= current_)
+        {
+            deadline = current_ + 1;
+        }
+        else if (SPAN <= deadline - current_)
+        {
+            deadline = current_ + SPAN - 1;
+        }
+        armed_.emplace(key, deadline);
+        insert(Timer{key, deadline});
+        rv = true;
+    }
+    return rv;
+}
+
+inline bool TimerWheel::disarm(
+        uint64_t key)
+{
+    return (0 != armed_.erase(key));
+}
+
+template<typename F>
+inline void TimerWheel::advance(
+        uint64_t now,
+        F&& on_expired)
+{
+    if (armed_.empty())
+    {
+        /* Nothing to wait for, only stale entries may remain. */
+        clear();
+        current_ = (current_ < now) ? now : current_;
+        return;
+    }
+
+    std::vector<Timer> expired;
+    while (current_ < now)
+    {
+        ++current_;
+        for (size_t level = 1; level < LEVELS; ++level)
+        {
+            if (0 != (current_ & ((uint64_t(1) << (SLOT_BITS * level)) - 1)))
+            {
+                break;
+            }
+            cascade(level);
+        }
+
+        expired.clear();
+        expired.swap(wheels_[0][current_ & (SLOTS - 1)]);
+        for (const Timer& timer : expired)
+        {
+            auto it = armed_.find(timer.key);
+            if ((armed_.end() != it) && (timer.deadline == it->second))
+            {
+                armed_.erase(it);
+                on_expired(timer.key);
+            }
+        }
+    }
+}
+
+inline void TimerWheel::insert(
+        const Timer& timer)
+{
+    const uint64_t delta = timer.deadline - current_;
+    size_t level = 0;
+    while ((level + 1 < LEVELS) && ((uint64_t(1) << (SLOT_BITS * (level + 1))) <= delta))
+    {
+        ++level;
+    }
+    wheels_[level][(timer.deadline >> (SLOT_BITS * level)) & (SLOTS - 1)].push_back(timer);
+}
+
+inline void TimerWheel::cascade(
+        size_t level)
+{
+    std::vector<Timer> timers;
+    timers.swap(wheels_[level][(current_ >> (SLOT_BITS * level)) & (SLOTS - 1)]);
+    for (const Timer& timer : timers)
+    {
+        auto it = armed_.find(timer.key);
+        if ((armed_.end() != it) && (timer.deadline == it->second))
+        {
+            insert(timer);
+        }
+    }
+}
+
+inline void TimerWheel::clear()
+{
+    for (auto& wheel : wheels_)
+    {
+        for (auto& slot : wheel)
+        {
+            slot.clear();
+        }
+    }
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
+
+#endif // UXR_AGENT_UTILS_TIMERWHEEL_HPP_
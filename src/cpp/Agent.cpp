@@ -535,6 +535,14 @@ void Agent::set_verbose_level(uint8_t verbose_level)
     root_->set_verbose_level(verbose_level);
 }
 
+bool Agent::set_thread_settings(
+        ThreadKind thread_kind,
+        const std::vector<uint16_t>& cpus,
+        uint8_t priority)
+{
+    return utils::set_thread_settings(thread_kind, ThreadSettings{cpus, priority});
+}
+
 /**********************************************************************************************************************
  * Write Data.
  **********************************************************************************************************************/
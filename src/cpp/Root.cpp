@@ -22,6 +22,7 @@
 #include <fastrtps/xmlparser/XMLProfileManager.h>
 #endif
 
+#include <atomic>
 #include <memory>
 #include <chrono>
 
@@ -30,12 +31,23 @@ constexpr dds::xrce::XrceVendorId EPROSIMA_VENDOR_ID = {0x01, 0x0F};
 namespace eprosima {
 namespace uxr {
 
+namespace {
+
+/* Versions of the client snapshots, shared by every Root so that a cached snapshot never matches another one. */
+std::atomic<uint64_t> last_clients_version{0};
+
+} // unnamed namespace
+
 Root::Root()
     : mtx_(),
-      clients_(),
+      clients_(std::make_shared<const ClientMap>()),
+      version_(last_clients_version.fetch_add(1, std::memory_order_relaxed) + 1),
+      stream_depths_(),
+      max_stream_depth_(DEFAULT_MAX_CLIENT_STREAM_DEPTH),
+      iteration_mtx_(),
+      iteration_clients_(),
       current_client_()
 {
-    current_client_ = clients_.begin();
 #ifdef UAGENT_LOGGER_PROFILE
     spdlog::set_level(spdlog::level::info);
     spdlog::set_pattern(UXR_LOG_PATTERN);
@@ -45,10 +57,9 @@ Root::Root()
 /* It must be here instead of the hpp because the forward declaration of Middleware in the hpp. */
 Root::~Root()
 {
-    for (auto it = clients_.begin(); it != clients_.end(); )
+    for (const auto& it : *clients_)
     {
-        it->second->release();
-        it = clients_.erase(it);
+        it.second->release();
     }
 }
 
@@ -77,29 +88,35 @@ dds::xrce::ResultStatus Root::create_client(
     {
         if (client_representation.xrce_version()[0] == dds::xrce::XRCE_VERSION_MAJOR)
         {
-            std::lock_guard<std::mutex> lock(mtx_);
+            std::unique_lock<std::mutex> lock(mtx_);
             dds::xrce::ClientKey client_key = client_representation.client_key();
             dds::xrce::SessionId session_id = client_representation.session_id();
-            auto it = clients_.find(client_key);
-            if (it == clients_.end())
+            std::unordered_map<std::string, std::string> client_properties;
+            if (client_representation.properties())
             {
-                std::unordered_map<std::string, std::string> client_properties;
-
-                if (client_representation.properties())
-                {   
-                    auto v = *client_representation.properties();
-                    for (auto it_props = v.begin(); it_props != v.end(); ++it_props)
-                    {
-                        client_properties.insert(std::pair<std::string, std::string>(it_props->name(), it_props->value()));
-                    }
+                auto v = *client_representation.properties();
+                for (auto it_props = v.begin(); it_props != v.end(); ++it_props)
+                {
+                    client_properties.insert(std::pair<std::string, std::string>(it_props->name(), it_props->value()));
                 }
+            }
 
+            const uint32_t raw_client_key = conversion::clientkey_to_raw(client_key);
+            std::shared_ptr<const ClientMap> clients = clients_;
+            auto it = clients->find(raw_client_key);
+            if (it == clients->end())
+            {
                 std::shared_ptr<ProxyClient> new_client = std::make_shared<ProxyClient>(
                     client_representation,
                     middleware_kind,
-                    std::move(client_properties));
-                if (clients_.emplace(client_key, std::move(new_client)).second)
+                    std::move(client_properties),
+                    stream_depths_,
+                    max_stream_depth_);
+                std::shared_ptr<ClientMap> new_clients = std::make_shared<ClientMap>(*clients);
+                if (new_clients->emplace(raw_client_key, std::move(new_client)).second)
                 {
+                    store_clients(std::move(new_clients));
+
                     UXR_AGENT_LOG_INFO(
                         UXR_DECORATE_GREEN("create"),
                         UXR_CREATE_SESSION_PATTERN,
@@ -118,12 +135,21 @@ dds::xrce::ResultStatus Root::create_client(
             }
             else
             {
-                std::shared_ptr<ProxyClient> client = clients_.at(client_key);
+                std::shared_ptr<ProxyClient> client = it->second;
                 if (session_id != client->get_session_id())
                 {
-                    it->second = std::make_shared<ProxyClient>(
+                    std::shared_ptr<ClientMap> new_clients = std::make_shared<ClientMap>(*clients);
+                    (*new_clients)[raw_client_key] = std::make_shared<ProxyClient>(
                         client_representation,
-                        middleware_kind);
+                        middleware_kind,
+                        std::move(client_properties),
+                        stream_depths_,
+                        max_stream_depth_);
+                    store_clients(std::move(new_clients));
+                    lock.unlock();
+
+                    /* The snapshots cached by the threads may keep the replaced client alive for a while. */
+                    client->release();
                 }
                 else
                 {
@@ -179,15 +205,19 @@ dds::xrce::ResultStatus Root::get_info(dds::xrce::ObjectInfo& agent_info)
 dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_key)
 {
     dds::xrce::ResultStatus result_status;
-    if (std::shared_ptr<ProxyClient> client = get_client(client_key))
+    const uint32_t raw_client_key = conversion::clientkey_to_raw(client_key);
+    std::unique_lock<std::mutex> lock(mtx_);
+    std::shared_ptr<const ClientMap> clients = clients_;
+    auto it = clients->find(raw_client_key);
+    if (it != clients->end())
     {
-        std::lock_guard<std::mutex> lock(mtx_);
-        if (current_client_ != clients_.end() && client_key == current_client_->first)
-        {
-            ++current_client_;
-        }
+        std::shared_ptr<ProxyClient> client = it->second;
+        std::shared_ptr<ClientMap> new_clients = std::make_shared<ClientMap>(*clients);
+        new_clients->erase(raw_client_key);
+        store_clients(std::move(new_clients));
+        lock.unlock();
+
         client->release();
-        clients_.erase(client_key);
         result_status.status(dds::xrce::STATUS_OK);
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("delete"),
@@ -196,6 +226,7 @@ dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_k
     }
     else
     {
+        lock.unlock();
         result_status.status(dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE);
 
         UXR_AGENT_LOG_INFO(
@@ -209,11 +240,11 @@ dds::xrce::ResultStatus Root::delete_client(const dds::xrce::ClientKey& client_k
 std::shared_ptr<ProxyClient> Root::get_client(const dds::xrce::ClientKey& client_key)
 {
     std::shared_ptr<ProxyClient> client;
-    std::lock_guard<std::mutex> lock(mtx_);
-    auto it = clients_.find(client_key);
-    if (it != clients_.end())
+    const std::shared_ptr<const ClientMap>& clients = load_clients();
+    auto it = clients->find(conversion::clientkey_to_raw(client_key));
+    if (it != clients->end())
     {
-        client = clients_.at(client_key);
+        client = it->second;
     }
     return client;
 }
@@ -221,8 +252,14 @@ std::shared_ptr<ProxyClient> Root::get_client(const dds::xrce::ClientKey& client
 bool Root::get_next_client(std::shared_ptr<ProxyClient>& next_client)
 {
     bool rv = false;
-    std::lock_guard<std::mutex> lock(mtx_);
-    if (current_client_ != clients_.end())
+    std::lock_guard<std::mutex> lock(iteration_mtx_);
+    if (!iteration_clients_)
+    {
+        iteration_clients_ = load_clients();
+        current_client_ = iteration_clients_->begin();
+    }
+
+    if (current_client_ != iteration_clients_->end())
     {
         next_client = current_client_->second;
         ++current_client_;
@@ -230,11 +267,37 @@ bool Root::get_next_client(std::shared_ptr<ProxyClient>& next_client)
     }
     else
     {
-        current_client_ = clients_.begin();
+        iteration_clients_.reset();
     }
     return rv;
 }
 
+const std::shared_ptr<const Root::ClientMap>& Root::load_clients()
+{
+    /* A single snapshot per thread, as there is usually a single Root. A stale one only keeps
+       the memory of deleted clients, already released, until the thread looks a client up again. */
+    struct Snapshot
+    {
+        uint64_t version;
+        std::shared_ptr<const ClientMap> clients;
+    };
+    static thread_local Snapshot snapshot{0, nullptr};
+
+    if (version_.load(std::memory_order_acquire) != snapshot.version)
+    {
+        std::lock_guard<std::mutex> lock(mtx_);
+        snapshot.version = version_.load(std::memory_order_relaxed);
+        snapshot.clients = clients_;
+    }
+    return snapshot.clients;
+}
+
+void Root::store_clients(std::shared_ptr<const ClientMap> clients)
+{
+    clients_ = std::move(clients);
+    version_.store(last_clients_version.fetch_add(1, std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
 bool Root::load_config_file(const std::string& file_path)
 {
 #ifdef UAGENT_FAST_PROFILE
@@ -245,6 +308,18 @@ bool Root::load_config_file(const std::string& file_path)
 #endif
 }
 
+void Root::set_stream_depths(const StreamDepths& stream_depths)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    stream_depths_ = stream_depths;
+}
+
+void Root::set_max_stream_depth(uint16_t max_stream_depth)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    max_stream_depth_ = max_stream_depth;
+}
+
 void Root::set_verbose_level(uint8_t verbose_level)
 {
 #ifdef UAGENT_LOGGER_PROFILE
@@ -305,14 +380,18 @@ void Root::set_verbose_level(uint8_t verbose_level)
 
 void Root::reset()
 {
-    std::lock_guard<std::mutex> lock(mtx_);
-    for (auto it = clients_.begin(); it != clients_.end(); )
+    std::unique_lock<std::mutex> lock(mtx_);
+    std::shared_ptr<const ClientMap> clients = clients_;
+    store_clients(std::make_shared<const ClientMap>());
+    lock.unlock();
+
+    for (const auto& it : *clients)
     {
-        it->second->release();
-        it = clients_.erase(it);
+        it.second->release();
     }
-    clients_.clear();
-    current_client_ = clients_.begin();
+
+    std::lock_guard<std::mutex> iteration_lock(iteration_mtx_);
+    iteration_clients_.reset();
 }
 
 } // namespace uxr
@@ -22,6 +22,11 @@
 #include <uxr/agent/topic/Topic.hpp>
 #include <uxr/agent/logger/Logger.hpp>
 
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+
 #ifdef UAGENT_FAST_PROFILE
 #include <uxr/agent/middleware/fast/FastMiddleware.hpp>
 #include <uxr/agent/middleware/fastdds/FastDDSMiddleware.hpp>
@@ -34,17 +39,76 @@
 namespace eprosima {
 namespace uxr {
 
+namespace {
+
+uint16_t get_depth_property(
+        const std::unordered_map<std::string, std::string>& properties,
+        const std::string& name,
+        uint16_t default_depth,
+        uint16_t max_depth)
+{
+    uint16_t rv = default_depth;
+    auto it = properties.find(name);
+    if (it != properties.end())
+    {
+        const std::string& value = it->second;
+        char* end = nullptr;
+        errno = 0;
+        unsigned long depth = std::strtoul(value.c_str(), &end, 10);
+        if (value.empty() || !std::isdigit(static_cast<unsigned char>(value.front()))
+            || ('\0' != *end) || (0 != errno) || (0 == depth))
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("invalid stream depth, using the default"),
+                "property: {}, value: {}, depth: {}",
+                name, value, default_depth);
+        }
+        else
+        {
+            /* Clients may ask for deeper streams than the default, up to the maximum of the agent. */
+            rv = uint16_t(std::min<unsigned long>(depth, std::max(max_depth, default_depth)));
+        }
+    }
+    return rv;
+}
+
+StreamDepths get_stream_depths(
+        const std::unordered_map<std::string, std::string>& properties,
+        const StreamDepths& default_depths,
+        uint16_t max_depth)
+{
+    return StreamDepths(
+        get_depth_property(properties, "uxr_reliable_depth", default_depths.reliable, max_depth),
+        get_depth_property(properties, "uxr_best_effort_depth", default_depths.best_effort, max_depth));
+}
+
+} // unnamed namespace
+
 ProxyClient::ProxyClient(
         const dds::xrce::CLIENT_Representation& representation,
         Middleware::Kind middleware_kind,
-        std::unordered_map<std::string, std::string>&& properties)
+        std::unordered_map<std::string, std::string>&& properties,
+        const StreamDepths& stream_depths,
+        uint16_t max_stream_depth)
     : representation_(representation)
     , objects_()
-    , session_(SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()})
+    /* Stream depths requested by the client, read before properties are moved into properties_. */
+    , session_(
+        SessionInfo{representation.client_key(), representation.session_id(), representation.mtu()},
+        get_stream_depths(properties, stream_depths, max_stream_depth))
     , state_{State::alive}
     , timestamp_{std::chrono::steady_clock::now()}
     , properties_(std::move(properties))
+    , output_weight_{1}
 {
+    /* Share of the output bandwidth with respect to other clients (fair queueing). */
+    auto it_weight = properties_.find("uxr_weight");
+    if (it_weight != properties_.end())
+    {
+        unsigned long weight = std::strtoul(it_weight->second.c_str(), nullptr, 10);
+        output_weight_ = uint16_t(std::min<unsigned long>(std::max<unsigned long>(weight, 1), UINT16_MAX));
+    }
+
     switch (middleware_kind)
     {
         case Middleware::Kind::NONE:
@@ -738,13 +802,14 @@ bool ProxyClient::delete_object_unlock(
     return rv;
 }
 
-ProxyClient::State ProxyClient::get_state()
+ProxyClient::State ProxyClient::get_state(
+        std::chrono::milliseconds dead_time)
 {
     std::lock_guard<std::mutex> lock(state_mtx_);
     if (State::alive == state_)
     {
         using namespace std::chrono;
-        state_ = (duration_cast<milliseconds>(steady_clock::now() - timestamp_) < CLIENT_DEAD_TIME)
+        state_ = (duration_cast<milliseconds>(steady_clock::now() - timestamp_) < dead_time)
             ? State::alive
             : State::dead;
     }
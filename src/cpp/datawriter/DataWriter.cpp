@@ -108,6 +108,21 @@ bool DataWriter::write(dds::xrce::WRITE_DATA_Payload_Data& write_data)
     return rv;
 }
 
+bool DataWriter::write(const uint8_t* buf, size_t len)
+{
+    bool rv = false;
+    if (proxy_client_->get_middleware().write_data(get_raw_id(), buf, len))
+    {
+        UXR_AGENT_LOG_MESSAGE(
+            UXR_DECORATE_YELLOW("[** <<DDS>> **]"),
+            get_raw_id(),
+            buf,
+            len);
+        rv = true;
+    }
+    return rv;
+}
+
 bool DataWriter::write(const std::vector<uint8_t>& data)
 {
     bool rv = false;
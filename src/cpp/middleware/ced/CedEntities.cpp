@@ -156,7 +156,8 @@ const std::string& CedGlobalTopic::name() const
 }
 
 bool CedGlobalTopic::write(
-        const std::vector<uint8_t>& data,
+        const uint8_t* buf,
+        size_t len,
         WriteAccess write_access,
         TopicSource topic_src,
         uint8_t& errcode)
@@ -166,7 +167,7 @@ bool CedGlobalTopic::write(
     {
         std::unique_lock<std::mutex> lock(mtx_);
         size_t index = uint16_t(last_write_ + 1) % history_.size();
-        history_[index] = data;
+        history_[index].assign(buf, buf + len);
         srcs_[index] = topic_src;
         ++last_write_;
         lock.unlock();
@@ -300,7 +301,15 @@ bool CedDataWriter::write(
         const std::vector<uint8_t>& data,
         uint8_t& errcode) const
 {
-    return topic_->get_global_topic()->write(data, write_access_, topic_src_, errcode);
+    return write(data.data(), data.size(), errcode);
+}
+
+bool CedDataWriter::write(
+        const uint8_t* buf,
+        size_t len,
+        uint8_t& errcode) const
+{
+    return topic_->get_global_topic()->write(buf, len, write_access_, topic_src_, errcode);
 }
 
 /**********************************************************************************************************************
@@ -299,6 +299,21 @@ bool CedMiddleware::write_data(
     return rv;
 }
 
+bool CedMiddleware::write_data(
+        uint16_t datawriter_id,
+        const uint8_t* buf,
+        size_t len)
+{
+    bool rv = false;
+    auto it = datawriters_.find(datawriter_id);
+    if (datawriters_.end() != it)
+    {
+        uint8_t errcode;
+        rv = it->second->write(buf, len, errcode);
+    }
+    return rv;
+}
+
 bool CedMiddleware::read_data(
         uint16_t datareader_id,
         std::vector<uint8_t>& data,
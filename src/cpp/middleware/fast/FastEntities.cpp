@@ -239,14 +239,24 @@ bool FastDataWriter::match(
 bool FastDataWriter::write(
         const std::vector<uint8_t>& data)
 {
-    return impl_->write(&const_cast<std::vector<uint8_t>&>(data));
+    return write(data.data(), data.size());
 }
 
 bool FastDataWriter::write(
-        const std::vector<uint8_t>& data,
+        const uint8_t* buf,
+        size_t len)
+{
+    SerializedSample sample{buf, len};
+    return impl_->write(&sample);
+}
+
+bool FastDataWriter::write(
+        const uint8_t* buf,
+        size_t len,
         fastrtps::rtps::WriteParams& wparams)
 {
-    return impl_->write(&const_cast<std::vector<uint8_t>&>(data), wparams);
+    SerializedSample sample{buf, len};
+    return impl_->write(&sample, wparams);
 }
 
 const fastrtps::rtps::GUID_t& FastDataWriter::get_guid() const
@@ -369,7 +379,7 @@ bool FastRequester::write(
     try
     {
         fastrtps::rtps::WriteParams wparams;
-        rv = datawriter_->write(data, wparams);
+        rv = datawriter_->write(data.data(), data.size(), wparams);
         if (rv)
         {
             int64_t sequence = (int64_t)wparams.sample_identity().sequence_number().high << 32;
@@ -514,10 +524,9 @@ bool FastReplier::write(
     fastrtps::rtps::WriteParams wparams;
     transport_sample_identity(sample_identity, wparams.related_sample_identity());
 
-    std::vector<uint8_t> output_data(data.size() - deserializer.getSerializedDataLength());
-    deserializer.deserializeArray(output_data.data(), output_data.size());
+    const size_t offset = deserializer.getSerializedDataLength();
 
-    return datawriter_->write(output_data, wparams);
+    return datawriter_->write(data.data() + offset, data.size() - offset, wparams);
 }
 
 bool FastReplier::read(
@@ -688,6 +688,20 @@ bool FastMiddleware::write_data(
     return rv;
 }
 
+bool FastMiddleware::write_data(
+        uint16_t datawriter_id,
+        const uint8_t* buf,
+        size_t len)
+{
+    bool rv = false;
+    auto it = datawriters_.find(datawriter_id);
+    if (datawriters_.end() != it)
+    {
+        rv = it->second->write(buf, len);
+    }
+    return rv;
+}
+
 bool FastMiddleware::write_request(
         uint16_t requester_id,
         uint32_t sequence_number,
@@ -592,7 +592,13 @@ bool FastDDSDataWriter::match(const fastrtps::PublisherAttributes& attrs) const
 
 bool FastDDSDataWriter::write(const std::vector<uint8_t>& data)
 {
-    return ptr_->write(&const_cast<std::vector<uint8_t>&>(data));
+    return write(data.data(), data.size());
+}
+
+bool FastDDSDataWriter::write(const uint8_t* buf, size_t len)
+{
+    SerializedSample sample{buf, len};
+    return ptr_->write(&sample);
 }
 
 const fastdds::dds::DataWriter* FastDDSDataWriter::ptr() const
@@ -815,7 +821,8 @@ bool FastDDSRequester::write(
     try
     {
         fastrtps::rtps::WriteParams wparams;
-        rv = datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(data), wparams);
+        SerializedSample sample{data.data(), data.size()};
+        rv = datawriter_ptr_->write(&sample, wparams);
         if (rv)
         {
             int64_t sequence = (int64_t)wparams.sample_identity().sequence_number().high << 32;
@@ -1002,10 +1009,10 @@ bool FastDDSReplier::write(
     fastrtps::rtps::WriteParams wparams;
     transport_sample_identity(sample_identity, wparams.related_sample_identity());
 
-    std::vector<uint8_t> output_data(data.size() - deserializer.getSerializedDataLength());
-    deserializer.deserializeArray(output_data.data(), output_data.size());
+    const size_t offset = deserializer.getSerializedDataLength();
+    SerializedSample sample{data.data() + offset, data.size() - offset};
 
-    return datawriter_ptr_->write(&const_cast<std::vector<uint8_t>&>(output_data), wparams);
+    return datawriter_ptr_->write(&sample, wparams);
 }
 
 void FastDDSReplier::transform_sample_identity(
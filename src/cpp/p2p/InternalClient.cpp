@@ -16,6 +16,7 @@
 #include <uxr/agent/middleware/ced/CedEntities.hpp>
 #include <uxr/agent/Agent.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
 #include <ucdr/microcdr.h>
 
 #include <string>
@@ -359,6 +360,7 @@ void InternalClient::create_topic_entities()
 
 void InternalClient::loop()
 {
+    utils::configure_current_thread(ThreadKind::AUXILIARY, "uxr-p2p");
 
     while (running_cond_)
     {
@@ -18,6 +18,7 @@
 #include <uxr/agent/requester/Requester.hpp>
 #include <uxr/agent/replier/Replier.hpp>
 #include <uxr/agent/Root.hpp>
+#include <uxr/agent/message/DataPayloadView.hpp>
 #include <uxr/agent/transport/Server.hpp>
 #include <uxr/agent/utils/Time.hpp>
 
@@ -26,9 +27,15 @@
 #include <uxr/agent/transport/endpoint/SerialEndPoint.hpp>
 #include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
 
+#include <algorithm>
+
 namespace eprosima {
 namespace uxr {
 
+/* Flush and ACKNACK timers share the wheel with the heartbeat ones, above their client key and stream id. */
+constexpr uint64_t FLUSH_TIMER_FLAG = uint64_t(1) << 40;
+constexpr uint64_t ACKNACK_TIMER_FLAG = uint64_t(1) << 41;
+
 template<typename EndPoint>
 Processor<EndPoint>::Processor(
         Server<EndPoint>& server,
@@ -37,6 +44,11 @@ Processor<EndPoint>::Processor(
     : server_(server)
     , middleware_kind_{middleware_kind}
     , root_(root)
+    , heartbeat_epoch_(std::chrono::steady_clock::now())
+    , timer_shards_()
+    , expired_heartbeats_()
+    , expired_flushes_()
+    , expired_acknacks_()
 {}
 
 template<typename EndPoint>
@@ -59,7 +71,7 @@ void Processor<EndPoint>::process_input_packet(
                 {
                     OutputPacket<EndPoint> output_packet;
                     process_get_info_packet(std::move(input_packet), output_packet);
-                    server_.push_output_packet(std::move(output_packet));
+                    server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_CONTROL);
                     break;
                 }
                 default:
@@ -94,7 +106,7 @@ void Processor<EndPoint>::process_input_packet(
             Session& session = client->session();
             dds::xrce::StreamId stream_id = input_packet.message->get_header().stream_id();
             dds::xrce::SequenceNr sequence_nr = input_packet.message->get_header().sequence_nr();
-            session.push_input_message(std::move(input_packet.message), stream_id, sequence_nr);
+            const bool accepted = session.push_input_message(std::move(input_packet.message), stream_id, sequence_nr);
             while (session.pop_input_message(stream_id, input_packet.message))
             {
                 process_input_message(*client, input_packet);
@@ -102,31 +114,18 @@ void Processor<EndPoint>::process_input_packet(
 
             if (is_reliable_stream(stream_id))
             {
-                dds::xrce::MessageHeader acknack_header;
-                acknack_header.session_id(header.session_id());
-                acknack_header.stream_id(dds::xrce::STREAMID_NONE);
-                acknack_header.sequence_nr(0x00);
-                acknack_header.client_key(header.client_key());
-
-                dds::xrce::ACKNACK_Payload acknack_payload;
-                client->session().fill_acknack(stream_id, acknack_payload);
-                acknack_payload.stream_id(header.stream_id());
-
-                dds::xrce::SubmessageHeader acknack_subheader;
-                acknack_subheader.submessage_id(dds::xrce::ACKNACK);
-                acknack_subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-                acknack_subheader.submessage_length(uint16_t(acknack_payload.getCdrSerializedSize()));
-
-                const size_t message_size = acknack_header.getCdrSerializedSize() +
-                                            acknack_subheader.getCdrSerializedSize() +
-                                            acknack_payload.getCdrSerializedSize();
-
-                OutputPacket<EndPoint> output_packet;
-                output_packet.destination = input_packet.source;
-                output_packet.message.reset(new OutputMessage(acknack_header, message_size));
-                output_packet.message->append_submessage(dds::xrce::ACKNACK, acknack_payload);
-
-                server_.push_output_packet(std::move(output_packet));
+                /* Duplicated or out of window messages, as well as gaps, are answered at once. The rest are
+                   acknowledged together once enough of them are received or the delay expires. */
+                if (!accepted ||
+                    (0 == server_.acknack_max_delay_.count()) ||
+                    session.is_acknack_due(stream_id, server_.acknack_max_messages_))
+                {
+                    send_acknack(*client, stream_id, input_packet.source);
+                }
+                else
+                {
+                    arm_acknack(*client, stream_id, server_.acknack_max_delay_);
+                }
             }
         }
         else
@@ -150,10 +149,10 @@ void Processor<EndPoint>::process_input_packet(
 
                     OutputPacket<EndPoint> output_packet;
                     output_packet.destination = input_packet.source;
-                    output_packet.message.reset(new OutputMessage(input_packet.message->get_header(), message_size));
+                    output_packet.message = OutputMessage::create(input_packet.message->get_header(), message_size);
                     output_packet.message->append_submessage(dds::xrce::STATUS, status_payload);
 
-                    server_.push_output_packet(std::move(output_packet));
+                    server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_CONTROL);
                 }
             }
         }
@@ -264,6 +263,12 @@ bool Processor<EndPoint>::process_create_client_submessage(
                 server_.establish_session(input_packet.source,
                                           conversion::clientkey_to_raw(client_payload.client_representation().client_key()),
                                           client_payload.client_representation().session_id());
+
+                std::shared_ptr<ProxyClient> client = root_.get_client(client_payload.client_representation().client_key());
+                if (client)
+                {
+                    server_.set_output_weight(input_packet.source, client->get_output_weight());
+                }
             }
 
             dds::xrce::STATUS_AGENT_Payload status_agent;
@@ -281,10 +286,10 @@ bool Processor<EndPoint>::process_create_client_submessage(
 
             OutputPacket<EndPoint> output_packet;
             output_packet.destination = input_packet.source;
-            output_packet.message = std::shared_ptr<OutputMessage>(new OutputMessage(status_header, message_size));
+            output_packet.message = OutputMessage::create(status_header, message_size);
             output_packet.message->append_submessage(dds::xrce::STATUS_AGENT, status_agent);
 
-            server_.push_output_packet(std::move(output_packet));
+            server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_CONTROL);
         }
     }
     else
@@ -325,8 +330,9 @@ bool Processor<EndPoint>::process_create_submessage(
         output_packet.destination = input_packet.source;
         while (client.session().get_next_output_message(dds::xrce::STREAMID_BUILTIN_RELIABLE, output_packet.message))
         {
-            server_.push_output_packet(std::move(output_packet));
+            server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_RELIABLE);
         }
+        arm_heartbeat(client, dds::xrce::STREAMID_BUILTIN_RELIABLE);
     }
     return rv;
 }
@@ -364,7 +370,7 @@ bool Processor<EndPoint>::process_delete_submessage(
 
             while (client.session().get_next_output_message(dds::xrce::STREAMID_NONE, output_packet.message))
             {
-                server_.push_output_packet(std::move(output_packet));
+                server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_CONTROL);
             }
         }
         else
@@ -379,8 +385,9 @@ bool Processor<EndPoint>::process_delete_submessage(
 
             while (client.session().get_next_output_message(dds::xrce::STREAMID_BUILTIN_RELIABLE, output_packet.message))
             {
-                server_.push_output_packet(std::move(output_packet));
+                server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_RELIABLE);
             }
+            arm_heartbeat(client, dds::xrce::STREAMID_BUILTIN_RELIABLE);
         }
     }
     else
@@ -406,11 +413,23 @@ bool Processor<EndPoint>::process_write_data_submessage(
     {
         case dds::xrce::FORMAT_DATA_FLAG:
         {
-            dds::xrce::WRITE_DATA_Payload_Data data_payload;
-            data_payload.data().resize(submessage_length - data_payload.BaseObjectRequest::getCdrSerializedSize(0));
-            if (input_packet.message->get_payload(data_payload))
+            /* The data is written to the DataWriters straight from the message buffer. */
+            dds::xrce::BaseObjectRequest request;
+            const size_t request_len = request.getCdrSerializedSize(0);
+            const uint8_t* data = nullptr;
+            const size_t data_len = (request_len <= submessage_length) ? submessage_length - request_len : 0;
+            if ((request_len <= submessage_length) &&
+                input_packet.message->get_payload(request) &&
+                input_packet.message->get_raw_payload_view(data, data_len))
             {
-                const dds::xrce::ObjectId& object_id = data_payload.object_id();
+                const dds::xrce::ObjectId& object_id = request.object_id();
+                dds::xrce::WRITE_DATA_Payload_Data data_payload;
+                if (dds::xrce::OBJK_DATAWRITER != (object_id[1] & 0x0F))
+                {
+                    data_payload.request_id(request.request_id());
+                    data_payload.object_id(object_id);
+                    data_payload.data().serialized_data().assign(data, data + data_len);
+                }
                 switch (object_id[1] & 0x0F)
                 {
                     case dds::xrce::OBJK_DATAWRITER:
@@ -419,7 +438,7 @@ bool Processor<EndPoint>::process_write_data_submessage(
                                 std::dynamic_pointer_cast<DataWriter>(client.get_object(object_id));
                         if (nullptr != data_writer)
                         {
-                            written = data_writer->write(data_payload);
+                            written = data_writer->write(data, data_len);
                         }
                         break;
                     }
@@ -550,8 +569,9 @@ bool Processor<EndPoint>::process_read_data_submessage(
             output_packet.destination = input_packet.source;
             while (client.session().get_next_output_message(dds::xrce::STREAMID_BUILTIN_RELIABLE, output_packet.message))
             {
-                server_.push_output_packet(std::move(output_packet));
+                server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_RELIABLE);
             }
+            arm_heartbeat(client, dds::xrce::STREAMID_BUILTIN_RELIABLE);
         }
     }
     else
@@ -586,19 +606,28 @@ bool Processor<EndPoint>::process_acknack_submessage(
             {
                 if (client.session().get_output_message(stream_id, first_message + i, output_packet.message))
                 {
-                    server_.push_output_packet(std::move(output_packet));
+                    server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_RELIABLE);
                 }
             }
             if ((nack_bitmap.at(0) & mask) == mask)
             {
                 if (client.session().get_output_message(stream_id, first_message + i + 8, output_packet.message))
                 {
-                    server_.push_output_packet(std::move(output_packet));
+                    server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_RELIABLE);
                 }
             }
         }
 
-        client.session().update_from_acknack(stream_id, first_message);
+        if (client.session().update_from_acknack(stream_id, first_message))
+        {
+            /* Messages pushed meanwhile found the timer still armed and left it as is,
+               so the stream is checked again once it is disarmed. */
+            disarm_heartbeat(client, stream_id);
+            if (client.session().has_unacked_messages(stream_id))
+            {
+                arm_heartbeat(client, stream_id);
+            }
+        }
     }
     else
     {
@@ -624,23 +653,7 @@ bool Processor<EndPoint>::process_heartbeat_submessage(
         client.session().update_from_heartbeat(stream_id,
                                                heartbeat_payload.first_unacked_seq_nr(),
                                                heartbeat_payload.last_unacked_seq_nr());
-
-        dds::xrce::ACKNACK_Payload acknack_payload;
-        client.session().fill_acknack(stream_id, acknack_payload);
-        acknack_payload.stream_id(stream_id);
-
-        client.session().push_output_submessage(
-            dds::xrce::STREAMID_NONE,
-            dds::xrce::ACKNACK,
-            acknack_payload,
-            std::chrono::milliseconds(0));
-
-        OutputPacket<EndPoint> output_packet;
-        output_packet.destination = input_packet.source;
-        if (client.session().get_next_output_message(dds::xrce::STREAMID_NONE, output_packet.message))
-        {
-            server_.push_output_packet(std::move(output_packet));
-        }
+        send_acknack(client, stream_id, input_packet.source);
     }
     else
     {
@@ -704,7 +717,7 @@ bool Processor<EndPoint>::process_timestamp_submessage(
         output_packet.destination = input_packet.source;
         if (client.session().get_next_output_message(dds::xrce::STREAMID_NONE, output_packet.message))
         {
-            server_.push_output_packet(std::move(output_packet));
+            server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_CONTROL);
         }
     }
     else
@@ -726,19 +739,33 @@ bool Processor<EndPoint>::read_data_callback(
 {
     bool rv = false;
 
-    dds::xrce::DATA_Payload_Data data_payload;
-    data_payload.request_id(cb_args.request_id);
-    data_payload.object_id(cb_args.object_id);
-    data_payload.data().serialized_data(buffer);
+    /* The sample is serialized straight from the reader buffer into the output message. */
+    DataPayloadView data_payload(cb_args.request_id, cb_args.object_id, buffer.data(), buffer.size());
 
     OutputPacket<EndPoint> output_packet;
     if (server_.get_endpoint(conversion::clientkey_to_raw(cb_args.client_key), output_packet.destination))
     {
-        rv = cb_args.client->session().push_output_submessage(cb_args.stream_id, dds::xrce::DATA, data_payload, timeout);
+        /* With an aggregation budget the sample waits in the open message of the stream, which is sent
+           once full or flushed when the budget expires. */
+        const std::chrono::milliseconds budget = server_.aggregation_budget_;
+        const bool aggregate = (0 < budget.count()) && !is_none_stream(cb_args.stream_id);
+        rv = cb_args.client->session().push_output_submessage(
+            cb_args.stream_id, dds::xrce::DATA, data_payload, timeout, aggregate);
+        if (aggregate)
+        {
+            arm_flush(*cb_args.client, cb_args.stream_id, budget);
+        }
 
+        const uint8_t priority = is_reliable_stream(cb_args.stream_id)
+            ? OUTPUT_PRIORITY_RELIABLE
+            : OUTPUT_PRIORITY_BEST_EFFORT;
         while (cb_args.client->session().get_next_output_message(cb_args.stream_id, output_packet.message))
         {
-            server_.push_output_packet(std::move(output_packet));
+            server_.push_output_packet(std::move(output_packet), priority);
+        }
+        if (is_reliable_stream(cb_args.stream_id))
+        {
+            arm_heartbeat(*cb_args.client, cb_args.stream_id);
         }
     }
     else
@@ -785,8 +812,8 @@ bool Processor<EndPoint>::process_get_info_packet(
                                     info_payload.getCdrSerializedSize();
 
         output_packet.destination = input_packet.source;
-        output_packet.message = OutputMessagePtr(new OutputMessage(input_packet.message->get_header(),
-                                                                    message_size));
+        output_packet.message = OutputMessage::create(input_packet.message->get_header(),
+                                                      message_size);
         rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
     }
 
@@ -839,8 +866,8 @@ bool Processor<EndPoint>::process_get_info_packet(
                                             info_payload.getCdrSerializedSize();
 
                 output_packet.destination = input_packet.source;
-                output_packet.message = OutputMessagePtr(new OutputMessage(input_packet.message->get_header(),
-                                                                           message_size));
+                output_packet.message = OutputMessage::create(input_packet.message->get_header(),
+                                                              message_size);
                 rv = output_packet.message->append_submessage(dds::xrce::INFO, info_payload);
             }
         }
@@ -852,47 +879,218 @@ bool Processor<EndPoint>::process_get_info_packet(
 template<typename EndPoint>
 void Processor<EndPoint>::check_heartbeats()
 {
-    dds::xrce::MessageHeader header;
-    header.stream_id(dds::xrce::STREAMID_NONE);
-    header.sequence_nr(0x00);
-
-    dds::xrce::HEARTBEAT_Payload heartbeat;
+    expired_heartbeats_.clear();
+    expired_flushes_.clear();
+    expired_acknacks_.clear();
+    const uint64_t now = get_heartbeat_tick();
+    for (TimerShard& shard : timer_shards_)
+    {
+        std::lock_guard<std::mutex> lock(shard.mtx);
+        shard.timers.advance(now, [this](uint64_t key)
+        {
+            if (0 != (key & FLUSH_TIMER_FLAG))
+            {
+                expired_flushes_.push_back(key & ~FLUSH_TIMER_FLAG);
+            }
+            else if (0 != (key & ACKNACK_TIMER_FLAG))
+            {
+                expired_acknacks_.push_back(key & ~ACKNACK_TIMER_FLAG);
+            }
+            else
+            {
+                expired_heartbeats_.push_back(key);
+            }
+        });
+    }
 
-    dds::xrce::SubmessageHeader subheader;
-    subheader.submessage_id(dds::xrce::HEARTBEAT);
-    subheader.flags(dds::xrce::FLAG_LITTLE_ENDIANNESS);
-    subheader.submessage_length(uint16_t(heartbeat.getCdrSerializedSize()));
+    /* Aggregated messages whose budget expired are sent first, so that the heartbeats cover them. */
+    for (uint64_t key : expired_flushes_)
+    {
+        std::shared_ptr<ProxyClient> client = root_.get_client(conversion::raw_to_clientkey(uint32_t(key >> 8)));
+        if (client)
+        {
+            flush_output_stream(*client, uint8_t(key & 0xFF));
+        }
+    }
 
-    const size_t message_size =
-            header.getCdrSerializedSize() +
-            subheader.getCdrSerializedSize() +
-            heartbeat.getCdrSerializedSize();
+    /* Delayed ACKNACKs, unless sent meanwhile. */
+    for (uint64_t key : expired_acknacks_)
+    {
+        const uint32_t raw_client_key = uint32_t(key >> 8);
+        const uint8_t stream_id = uint8_t(key & 0xFF);
+        std::shared_ptr<ProxyClient> client = root_.get_client(conversion::raw_to_clientkey(raw_client_key));
+        EndPoint destination;
+        if (client &&
+            client->session().is_acknack_due(stream_id, 1) &&
+            server_.get_endpoint(raw_client_key, destination))
+        {
+            send_acknack(*client, stream_id, destination);
+        }
+    }
 
-    OutputPacket<EndPoint> output_packet;
+    /* Timer keys are made of the client key and the stream id (see arm_heartbeat),
+       so once sorted the expired timers of each client are contiguous. */
+    std::sort(expired_heartbeats_.begin(), expired_heartbeats_.end());
 
-    std::shared_ptr<ProxyClient> client;
-    while (root_.get_next_client(client))
+    auto it = expired_heartbeats_.begin();
+    while (it != expired_heartbeats_.end())
     {
-        if (server_.get_endpoint(conversion::clientkey_to_raw(client->get_client_key()), output_packet.destination) &&
-             ProxyClient::State::alive == client->get_state())
+        const uint32_t raw_client_key = uint32_t(*it >> 8);
+        while ((it != expired_heartbeats_.end()) && (raw_client_key == uint32_t(*it >> 8)))
+        {
+            ++it;
+        }
+
+        std::shared_ptr<ProxyClient> client = root_.get_client(conversion::raw_to_clientkey(raw_client_key));
+        if (!client)
         {
-            header.session_id(client->get_session_id());
-            header.client_key(client->get_client_key());
+            continue;
+        }
 
-            for (auto stream : client->session().get_output_streams())
+        /* All the streams with unacknowledged messages go in the same message, and their timers are
+           aligned so that they keep expiring together. Acknowledged streams stay disarmed. */
+        heartbeats_.clear();
+        client->session().for_each_unacked_stream([&](uint8_t stream_id)
+        {
+            dds::xrce::HEARTBEAT_Payload heartbeat;
+            if (client->session().fill_heartbeat(stream_id, heartbeat))
             {
-                if (client->session().fill_heartbeat(stream, heartbeat))
-                {
-                    output_packet.message = OutputMessagePtr(new OutputMessage(header, message_size));
-                    output_packet.message->append_submessage(dds::xrce::HEARTBEAT, heartbeat);
+                heartbeats_.push_back(heartbeat);
+                disarm_heartbeat(*client, stream_id);
+                arm_heartbeat(*client, stream_id);
+            }
+        });
 
-                    server_.push_output_packet(std::move(output_packet));
-                }
+        EndPoint destination;
+        if (!heartbeats_.empty() &&
+            server_.get_endpoint(raw_client_key, destination) &&
+            ProxyClient::State::alive == client->get_state(server_.client_dead_time_))
+        {
+            size_t index = 0;
+            while (index < heartbeats_.size())
+            {
+                OutputPacket<EndPoint> output_packet;
+                output_packet.destination = destination;
+                output_packet.message = client->session().get_control_messages().create_heartbeats(heartbeats_, index);
+                /* In the class of the reliable data they announce, so that they never overtake it. */
+                server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_RELIABLE);
             }
         }
     }
 }
 
+template<typename EndPoint>
+void Processor<EndPoint>::arm_heartbeat(
+        const ProxyClient& client,
+        uint8_t stream_id)
+{
+    const uint64_t key = (uint64_t(conversion::clientkey_to_raw(client.get_client_key())) << 8) | stream_id;
+    arm_timer(key, uint64_t(server_.heartbeat_period_.count()));
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::disarm_heartbeat(
+        const ProxyClient& client,
+        uint8_t stream_id)
+{
+    const uint64_t key = (uint64_t(conversion::clientkey_to_raw(client.get_client_key())) << 8) | stream_id;
+    disarm_timer(key);
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::arm_flush(
+        const ProxyClient& client,
+        uint8_t stream_id,
+        std::chrono::milliseconds budget)
+{
+    /* Armed by the first sample of the open message only, so that none waits longer than the budget. */
+    const uint64_t key = FLUSH_TIMER_FLAG
+        | (uint64_t(conversion::clientkey_to_raw(client.get_client_key())) << 8) | stream_id;
+    arm_timer(key, uint64_t(budget.count()));
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::flush_output_stream(
+        ProxyClient& client,
+        uint8_t stream_id)
+{
+    OutputPacket<EndPoint> output_packet;
+    if (client.session().flush_output_stream(stream_id) &&
+        server_.get_endpoint(conversion::clientkey_to_raw(client.get_client_key()), output_packet.destination))
+    {
+        const uint8_t priority = is_reliable_stream(stream_id)
+            ? OUTPUT_PRIORITY_RELIABLE
+            : OUTPUT_PRIORITY_BEST_EFFORT;
+        while (client.session().get_next_output_message(stream_id, output_packet.message))
+        {
+            server_.push_output_packet(std::move(output_packet), priority);
+        }
+        if (is_reliable_stream(stream_id))
+        {
+            arm_heartbeat(client, stream_id);
+        }
+    }
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::arm_acknack(
+        const ProxyClient& client,
+        uint8_t stream_id,
+        std::chrono::milliseconds delay)
+{
+    /* Armed by the first unacknowledged message only, so that none waits longer than the delay. */
+    const uint64_t key = ACKNACK_TIMER_FLAG
+        | (uint64_t(conversion::clientkey_to_raw(client.get_client_key())) << 8) | stream_id;
+    arm_timer(key, uint64_t(delay.count()));
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::send_acknack(
+        ProxyClient& client,
+        uint8_t stream_id,
+        const EndPoint& destination)
+{
+    dds::xrce::ACKNACK_Payload acknack_payload;
+    client.session().fill_acknack(stream_id, acknack_payload);
+    acknack_payload.stream_id(stream_id);
+
+    OutputPacket<EndPoint> output_packet;
+    output_packet.destination = destination;
+    output_packet.message = client.session().get_control_messages().create_acknack(acknack_payload);
+
+    server_.push_output_packet(std::move(output_packet), OUTPUT_PRIORITY_CONTROL);
+}
+
+template<typename EndPoint>
+uint64_t Processor<EndPoint>::get_heartbeat_tick() const
+{
+    return uint64_t(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - heartbeat_epoch_).count());
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::arm_timer(
+        uint64_t key,
+        uint64_t delay)
+{
+    /* The timer flags are dropped, so that all the timers of a client share a wheel. */
+    TimerShard& shard = timer_shards_[uint32_t(key >> 8) % TIMER_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.timers.arm(key, get_heartbeat_tick() + delay);
+}
+
+template<typename EndPoint>
+void Processor<EndPoint>::disarm_timer(
+        uint64_t key)
+{
+    TimerShard& shard = timer_shards_[uint32_t(key >> 8) % TIMER_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mtx);
+    shard.timers.disarm(key);
+}
+
+template<typename EndPoint>
+constexpr size_t Processor<EndPoint>::TIMER_SHARDS;
+
 template class Processor<IPv4EndPoint>;
 template class Processor<IPv6EndPoint>;
 template class Processor<SerialEndPoint>;
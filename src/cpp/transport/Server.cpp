@@ -17,13 +17,21 @@
 #include <uxr/agent/processor/Processor.hpp>
 #include <uxr/agent/Root.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/scheduler/FCFSScheduler.hpp>
+#include <uxr/agent/scheduler/RingScheduler.hpp>
+#include <uxr/agent/scheduler/PriorityScheduler.hpp>
+#include <uxr/agent/scheduler/DRRScheduler.hpp>
+#include <uxr/agent/utils/Conversion.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
 
 #include <uxr/agent/transport/endpoint/IPv4EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/IPv6EndPoint.hpp>
 #include <uxr/agent/transport/endpoint/SerialEndPoint.hpp>
 #include <uxr/agent/transport/endpoint/CustomEndPoint.hpp>
 
+#include <algorithm>
 #include <functional>
+#include <sstream>
 
 #define RECEIVE_TIMEOUT 1
 
@@ -35,16 +43,142 @@ extern template class Processor<IPv6EndPoint>;
 extern template class Processor<SerialEndPoint>;
 extern template class Processor<CustomEndPoint>;
 
+namespace {
+
+/* Reception time of the packet being processed by the current thread, stamped on its replies. */
+thread_local std::chrono::steady_clock::time_point processing_timestamp;
+
+/* Whether the current thread runs the event loop, so that its replies are sent inline. */
+thread_local bool inline_output = false;
+
+} // unnamed namespace
+
+/**************************************************************************************************
+ * Schedulers creation.
+ **************************************************************************************************/
+const size_t DRR_SCHEDULER_QUANTUM = 512;
+
+template<typename EndPoint>
+inline EndPoint packet_flow(const InputPacket<EndPoint>& input_packet)
+{
+    return input_packet.source;
+}
+
+template<typename EndPoint>
+inline EndPoint packet_flow(const OutputPacket<EndPoint>& output_packet)
+{
+    return output_packet.destination;
+}
+
+template<typename Packet>
+inline size_t packet_cost(const Packet& packet)
+{
+    return packet.message->get_len();
+}
+
+template<typename Packet, typename EndPoint>
+Scheduler<Packet>* create_scheduler(
+        SchedulerKind kind,
+        size_t max_size,
+        SessionManager<EndPoint>& session_manager)
+{
+    Scheduler<Packet>* scheduler = nullptr;
+    switch (kind)
+    {
+        case SchedulerKind::RING:
+            scheduler = new RingScheduler<Packet>(max_size);
+            break;
+        case SchedulerKind::PRIORITY:
+            scheduler = new PriorityScheduler<Packet>(max_size, OUTPUT_PRIORITY_LEVELS);
+            break;
+        case SchedulerKind::DRR:
+            scheduler = new DRRScheduler<Packet, EndPoint>(
+                max_size,
+                DRR_SCHEDULER_QUANTUM,
+                [](const Packet& packet) { return packet_flow(packet); },
+                [](const Packet& packet) { return packet_cost(packet); },
+                [&session_manager](const EndPoint& endpoint) { return session_manager.get_output_weight(endpoint); });
+            break;
+        case SchedulerKind::FCFS:
+        default:
+            scheduler = new FCFSScheduler<Packet>(max_size);
+            break;
+    }
+    return scheduler;
+}
+
+/**************************************************************************************************
+ * Processing workers dispatching.
+ **************************************************************************************************/
+inline size_t mix_hash(uint64_t value)
+{
+    /* Fibonacci hashing, spreads sequential keys among workers. */
+    return size_t((value * UINT64_C(0x9E3779B97F4A7C15)) >> 32);
+}
+
+inline size_t endpoint_hash(const IPv4EndPoint& endpoint)
+{
+    return mix_hash((uint64_t(endpoint.get_addr()) << 16) | endpoint.get_port());
+}
+
+inline size_t endpoint_hash(const IPv6EndPoint& endpoint)
+{
+    uint64_t value = endpoint.get_port();
+    for (uint8_t byte : endpoint.get_addr())
+    {
+        value = (value * 31) + byte;
+    }
+    return mix_hash(value);
+}
+
+inline size_t endpoint_hash(const SerialEndPoint& endpoint)
+{
+    return mix_hash(endpoint.get_addr());
+}
+
+inline size_t endpoint_hash(const CustomEndPoint& endpoint)
+{
+    std::stringstream ss;
+    ss << endpoint;
+    return std::hash<std::string>{}(ss.str());
+}
+
 template<typename EndPoint>
 Server<EndPoint>::Server(Middleware::Kind middleware_kind)
     : processor_(new Processor<EndPoint>(*this, *root_, middleware_kind))
     , running_cond_(false)
-    , input_scheduler_(SERVER_QUEUE_MAX_SIZE)
-    , output_scheduler_(SERVER_QUEUE_MAX_SIZE)
+    , receiver_threads_count_(1)
+    , processing_threads_count_(1)
+    , input_scheduler_kind_(SchedulerKind::FCFS)
+    , output_scheduler_kind_(SchedulerKind::FCFS)
+    , input_schedulers_()
+    , output_scheduler_(create_scheduler<OutputPacket<EndPoint>>(output_scheduler_kind_, SERVER_QUEUE_MAX_SIZE, *this))
+    , input_overflow_policy_(OverflowPolicy::DROP_OLDEST)
+    , output_overflow_policy_(OverflowPolicy::DROP_OLDEST)
+    , execution_mode_(ExecutionMode::THREADED)
+    , latency_()
+    , send_mtx_()
+    , recv_batch_size_(1)
+    , send_batch_size_(1)
+    , recv_packets_(0)
+    , recv_syscalls_(0)
+    , send_packets_(0)
+    , send_syscalls_(0)
+    , aggregation_budget_(0)
+    , acknack_max_messages_(1)
+    , acknack_max_delay_(0)
+    , heartbeat_period_(HEARTBEAT_PERIOD)
+    , queue_size_(SERVER_QUEUE_MAX_SIZE)
+    , client_dead_time_(CLIENT_DEAD_TIME)
     , transport_rc_{TransportRc::ok}
     , error_mtx_{}
     , error_cv_{}
-{}
+{
+    for (auto& dropped_packets : dropped_by_policy_)
+    {
+        dropped_packets = 0;
+    }
+}
 
 template<typename EndPoint>
 Server<EndPoint>::~Server()
@@ -64,16 +198,57 @@ bool Server<EndPoint>::start()
     }
 
     /* Scheduler initialization. */
-    input_scheduler_.init();
-    output_scheduler_.init();
+    input_schedulers_.clear();
+    for (uint16_t i = 0; i < processing_threads_count_; ++i)
+    {
+        input_schedulers_.emplace_back(
+            create_scheduler<InputPacket<EndPoint>>(input_scheduler_kind_, queue_size_, *this));
+        input_schedulers_.back()->set_overflow_policy(
+            input_overflow_policy_,
+            1,
+            [this](const InputPacket<EndPoint>& input_packet, OverflowPolicy policy)
+            {
+                account_dropped_packet(input_packet.source, policy);
+            });
+        input_schedulers_.back()->init();
+    }
+    output_scheduler_->set_overflow_policy(
+        output_overflow_policy_,
+        OUTPUT_PRIORITY_LEVELS,
+        [this](const OutputPacket<EndPoint>& output_packet, OverflowPolicy policy)
+        {
+            account_dropped_packet(output_packet.destination, policy);
+        });
+    output_scheduler_->init();
 
     /* Thread initialization. */
     running_cond_ = true;
+    latency_.reset();
+    recv_packets_ = 0;
+    recv_syscalls_ = 0;
+    send_packets_ = 0;
+    send_syscalls_ = 0;
     error_handler_thread_ = std::thread(&Server::error_handler_loop, this);
-    receiver_thread_ = std::thread(&Server::receiver_loop, this);
     sender_thread_ = std::thread(&Server::sender_loop, this);
-    processing_thread_ = std::thread(&Server::processing_loop, this);
-    heartbeat_thread_ = std::thread(&Server::heartbeat_loop, this);
+    if (ExecutionMode::EVENT_LOOP == execution_mode_)
+    {
+        for (size_t i = 0; i < get_receiver_count(); ++i)
+        {
+            event_loop_threads_.emplace_back(&Server::event_loop, this, i);
+        }
+    }
+    else
+    {
+        for (size_t i = 0; i < get_receiver_count(); ++i)
+        {
+            receiver_threads_.emplace_back(&Server::receiver_loop, this, i);
+        }
+        for (size_t i = 0; i < input_schedulers_.size(); ++i)
+        {
+            processing_threads_.emplace_back(&Server::processing_loop, this, i);
+        }
+        heartbeat_thread_ = std::thread(&Server::heartbeat_loop, this);
+    }
 
     return true;
 }
@@ -85,24 +260,43 @@ bool Server<EndPoint>::stop()
     running_cond_ = false;
 
     /* Stop input and output queues. */
-    input_scheduler_.deinit();
-    output_scheduler_.deinit();
+    for (auto& input_scheduler : input_schedulers_)
+    {
+        input_scheduler->deinit();
+    }
+    output_scheduler_->deinit();
 
     error_cv_.notify_one();
 
     /* Join threads. */
-    if (receiver_thread_.joinable())
+    for (auto& event_loop_thread : event_loop_threads_)
     {
-        receiver_thread_.join();
+        if (event_loop_thread.joinable())
+        {
+            event_loop_thread.join();
+        }
     }
+    event_loop_threads_.clear();
+    for (auto& receiver_thread : receiver_threads_)
+    {
+        if (receiver_thread.joinable())
+        {
+            receiver_thread.join();
+        }
+    }
+    receiver_threads_.clear();
     if (sender_thread_.joinable())
     {
         sender_thread_.join();
     }
-    if (processing_thread_.joinable())
+    for (auto& processing_thread : processing_threads_)
     {
-        processing_thread_.join();
+        if (processing_thread.joinable())
+        {
+            processing_thread.join();
+        }
     }
+    processing_threads_.clear();
     if (heartbeat_thread_.joinable())
     {
         heartbeat_thread_.join();
@@ -112,6 +306,29 @@ bool Server<EndPoint>::stop()
         error_handler_thread_.join();
     }
 
+    if (0 < latency_.get_count())
+    {
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("latency"),
+            "p50: {} us, p99: {} us, replies: {}",
+            get_latency(50.0).count(),
+            get_latency(99.0).count(),
+            latency_.get_count());
+    }
+    if ((0 < recv_syscalls_) || (0 < send_syscalls_))
+    {
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("packets per syscall"),
+            "recv: {:.2f}, send: {:.2f}",
+            get_recv_packets_per_syscall(),
+            get_send_packets_per_syscall());
+    }
+    UXR_AGENT_LOG_INFO(
+        UXR_DECORATE_GREEN("output messages"),
+        "created: {}, heap allocations: {}",
+        OutputMessage::get_creations(),
+        OutputMessage::get_allocations());
+
     /* Close servers. */
     bool rv = true;
     // TODO: check at run time if P2P and discovery are implemented
@@ -125,6 +342,266 @@ bool Server<EndPoint>::stop()
     return rv;
 }
 
+template<typename EndPoint>
+bool Server<EndPoint>::set_processing_threads(uint16_t processing_threads)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < processing_threads))
+    {
+        processing_threads_count_ = processing_threads;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_receiver_threads(uint16_t receiver_threads)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < receiver_threads))
+    {
+        receiver_threads_count_ = receiver_threads;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_scheduler_kind(
+        SchedulerKind input_kind,
+        SchedulerKind output_kind)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (SchedulerKind::PRIORITY != input_kind))
+    {
+        input_scheduler_kind_ = input_kind;
+        if (output_scheduler_kind_ != output_kind)
+        {
+            output_scheduler_kind_ = output_kind;
+            output_scheduler_.reset(
+                create_scheduler<OutputPacket<EndPoint>>(output_scheduler_kind_, queue_size_, *this));
+        }
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_overflow_policy(
+        OverflowPolicy input_policy,
+        OverflowPolicy output_policy)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_)
+    {
+        input_overflow_policy_ = input_policy;
+        output_overflow_policy_ = output_policy;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+uint64_t Server<EndPoint>::get_dropped_packets(
+        OverflowPolicy policy) const
+{
+    return dropped_by_policy_[size_t(policy)];
+}
+
+template<typename EndPoint>
+uint64_t Server<EndPoint>::get_dropped_packets(
+        const EndPoint& endpoint)
+{
+    return SessionManager<EndPoint>::get_dropped_packets(endpoint);
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_execution_mode(
+        ExecutionMode mode)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_)
+    {
+        execution_mode_ = mode;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+std::chrono::microseconds Server<EndPoint>::get_latency(
+        double percentile) const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(latency_.get_percentile(percentile));
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_batch_size(
+        uint16_t recv_batch_size,
+        uint16_t send_batch_size)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < recv_batch_size) && (0 < send_batch_size))
+    {
+        recv_batch_size_ = recv_batch_size;
+        send_batch_size_ = send_batch_size;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_aggregation_budget(
+        std::chrono::milliseconds budget)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 <= budget.count()))
+    {
+        aggregation_budget_ = budget;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_acknack_coalescing(
+        uint16_t max_messages,
+        std::chrono::milliseconds max_delay)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    /* Without a delay every message is acknowledged at once, so there is nothing to coalesce. */
+    if (!running_cond_ && (0 < max_messages) && (0 <= max_delay.count()) &&
+        ((1 == max_messages) || (0 < max_delay.count())))
+    {
+        acknack_max_messages_ = max_messages;
+        acknack_max_delay_ = max_delay;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_stream_depths(
+        uint16_t reliable_depth,
+        uint16_t best_effort_depth)
+{
+    bool rv = false;
+    if ((0 < reliable_depth) && (reliable_depth <= MAX_STREAM_DEPTH) &&
+        (0 < best_effort_depth) && (best_effort_depth <= MAX_STREAM_DEPTH))
+    {
+        root_->set_stream_depths(StreamDepths(reliable_depth, best_effort_depth));
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_max_stream_depth(
+        uint16_t max_depth)
+{
+    bool rv = false;
+    if ((0 < max_depth) && (max_depth <= MAX_STREAM_DEPTH))
+    {
+        root_->set_max_stream_depth(max_depth);
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_heartbeat_period(
+        std::chrono::milliseconds period)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < period.count()))
+    {
+        heartbeat_period_ = period;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_queue_size(
+        size_t queue_size)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < queue_size))
+    {
+        if (queue_size_ != queue_size)
+        {
+            queue_size_ = queue_size;
+            output_scheduler_.reset(
+                create_scheduler<OutputPacket<EndPoint>>(output_scheduler_kind_, queue_size_, *this));
+        }
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::set_client_dead_time(
+        std::chrono::milliseconds dead_time)
+{
+    std::lock_guard<std::mutex> lock(mtx_);
+    bool rv = false;
+    if (!running_cond_ && (0 < dead_time.count()))
+    {
+        client_dead_time_ = dead_time;
+        rv = true;
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+double Server<EndPoint>::get_recv_packets_per_syscall() const
+{
+    const uint64_t syscalls = recv_syscalls_;
+    return (0 != syscalls) ? double(recv_packets_) / double(syscalls) : 0.0;
+}
+
+template<typename EndPoint>
+double Server<EndPoint>::get_send_packets_per_syscall() const
+{
+    const uint64_t syscalls = send_syscalls_;
+    return (0 != syscalls) ? double(send_packets_) / double(syscalls) : 0.0;
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::account_recv_syscall(
+        size_t packets)
+{
+    recv_packets_.fetch_add(packets, std::memory_order_relaxed);
+    recv_syscalls_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::account_send_syscall(
+        size_t packets)
+{
+    send_packets_.fetch_add(packets, std::memory_order_relaxed);
+    send_syscalls_.fetch_add(1, std::memory_order_relaxed);
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::account_dropped_packet(
+        const EndPoint& endpoint,
+        OverflowPolicy policy)
+{
+    ++dropped_by_policy_[size_t(policy)];
+    SessionManager<EndPoint>::add_dropped_packet(endpoint);
+}
+
 #ifdef UAGENT_DISCOVERY_PROFILE
 template<typename EndPoint>
 bool Server<EndPoint>::enable_discovery(uint16_t discovery_port)
@@ -165,24 +642,46 @@ bool Server<EndPoint>::disable_p2p()
 
 template<typename EndPoint>
 void Server<EndPoint>::push_output_packet(
-        OutputPacket<EndPoint>&& output_packet)
+        OutputPacket<EndPoint>&& output_packet,
+        uint8_t priority)
 {
     if (output_packet.message)
     {
-        output_scheduler_.push(std::move(output_packet), 0);
+        output_packet.timestamp = processing_timestamp;
+        if (inline_output)
+        {
+            TransportRc transport_rc = TransportRc::ok;
+            if (!send_output_packet(output_packet, transport_rc) && (TransportRc::server_error == transport_rc))
+            {
+                /* Let the sender thread retry it once the error is handled. */
+                std::unique_lock<std::mutex> lock(error_mtx_);
+                transport_rc_ = transport_rc;
+                error_cv_.notify_one();
+                lock.unlock();
+                output_scheduler_->push(std::move(output_packet), priority);
+            }
+        }
+        else
+        {
+            output_scheduler_->push(std::move(output_packet), priority);
+        }
     }
 }
 
 template<typename EndPoint>
-void Server<EndPoint>::receiver_loop()
+void Server<EndPoint>::receiver_loop(size_t receiver_id)
 {
+    utils::configure_current_thread(
+        ThreadKind::RECEIVER,
+        (1 == get_receiver_count()) ? std::string("uxr-recv") : "uxr-recv-" + std::to_string(receiver_id));
     InputPacket<EndPoint> input_packet{};
     while (running_cond_)
     {
         TransportRc transport_rc = TransportRc::ok;
-        if (recv_message(input_packet, RECEIVE_TIMEOUT, transport_rc))
+        if (recv_message_from(receiver_id, input_packet, RECEIVE_TIMEOUT, transport_rc))
         {
-            input_scheduler_.push(std::move(input_packet), 0);
+            input_packet.timestamp = std::chrono::steady_clock::now();
+            input_schedulers_[get_processing_worker(input_packet)]->push(std::move(input_packet), 0);
         }
         else
         {
@@ -199,52 +698,199 @@ void Server<EndPoint>::receiver_loop()
 template<typename EndPoint>
 void Server<EndPoint>::sender_loop()
 {
-    OutputPacket<EndPoint> output_packet{};
+    utils::configure_current_thread(ThreadKind::SENDER, "uxr-send");
+    std::vector<OutputPacket<EndPoint>> output_packets;
+    output_packets.reserve(send_batch_size_);
     while (running_cond_)
     {
-        if (output_scheduler_.pop(output_packet))
+        /* Packets not sent due to a server error are kept and sent again in the next iteration. */
+        if (!output_packets.empty() || (0 < output_scheduler_->pop_batch(output_packets, send_batch_size_)))
         {
             TransportRc transport_rc = TransportRc::ok;
-            if (!send_message(output_packet, transport_rc))
+            if (!send_output_packets(output_packets, transport_rc))
             {
                 if (TransportRc::server_error == transport_rc)
                 {
                     std::unique_lock<std::mutex> lock(error_mtx_);
                     transport_rc_ = transport_rc;
-                    output_scheduler_.push_front(std::move(output_packet));
                     error_cv_.notify_one();
                 }
+                else
+                {
+                    /* Any other failure discards the packet, as a single send would. */
+                    output_packets.erase(output_packets.begin());
+                }
             }
         }
     }
 }
 
 template<typename EndPoint>
-void Server<EndPoint>::processing_loop()
+void Server<EndPoint>::processing_loop(size_t worker_id)
 {
+    utils::configure_current_thread(
+        ThreadKind::PROCESSING,
+        (1 == input_schedulers_.size()) ? std::string("uxr-proc") : "uxr-proc-" + std::to_string(worker_id));
     InputPacket<EndPoint> input_packet;
+    Scheduler<InputPacket<EndPoint>>& input_scheduler = *input_schedulers_[worker_id];
     while (running_cond_)
     {
-        if (input_scheduler_.pop(input_packet))
+        if (input_scheduler.pop(input_packet))
         {
+            processing_timestamp = input_packet.timestamp;
             processor_->process_input_packet(std::move(input_packet));
+            processing_timestamp = std::chrono::steady_clock::time_point();
+        }
+    }
+}
+
+template<typename EndPoint>
+void Server<EndPoint>::event_loop(size_t receiver_id)
+{
+    utils::configure_current_thread(
+        ThreadKind::RECEIVER,
+        (1 == get_receiver_count()) ? std::string("uxr-loop") : "uxr-loop-" + std::to_string(receiver_id));
+    using namespace std::chrono;
+
+    inline_output = true;
+    InputPacket<EndPoint> input_packet{};
+    steady_clock::time_point heartbeat_time = steady_clock::now() + get_timer_period();
+    while (running_cond_)
+    {
+        TransportRc transport_rc = TransportRc::ok;
+        if (recv_message_from(receiver_id, input_packet, RECEIVE_TIMEOUT, transport_rc))
+        {
+            processing_timestamp = steady_clock::now();
+            processor_->process_input_packet(std::move(input_packet));
+            processing_timestamp = steady_clock::time_point();
+        }
+        else if (TransportRc::server_error == transport_rc)
+        {
+            std::unique_lock<std::mutex> lock(error_mtx_);
+            transport_rc_ = transport_rc;
+            error_cv_.notify_one();
+        }
+
+        const steady_clock::time_point now = steady_clock::now();
+        if ((0 == receiver_id) && (heartbeat_time <= now))
+        {
+            /* Heartbeat timers are served by the first loop too, between packets. */
+            processor_->check_heartbeats();
+            heartbeat_time = now + get_timer_period();
+        }
+    }
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::recv_message_from(
+        size_t /*receiver_id*/,
+        InputPacket<EndPoint>& input_packet,
+        int timeout,
+        TransportRc& transport_rc)
+{
+    return recv_message(input_packet, timeout, transport_rc);
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::send_output_packet(
+        OutputPacket<EndPoint>& output_packet,
+        TransportRc& transport_rc)
+{
+    bool rv;
+    {
+        /* Serializes the inline sends of the event loop with those of the sender thread. */
+        std::lock_guard<std::mutex> lock(send_mtx_);
+        rv = send_message(output_packet, transport_rc);
+    }
+    if (rv && (std::chrono::steady_clock::time_point() != output_packet.timestamp))
+    {
+        latency_.record(std::chrono::steady_clock::now() - output_packet.timestamp);
+    }
+    return rv;
+}
+
+template<typename EndPoint>
+bool Server<EndPoint>::send_output_packets(
+        std::vector<OutputPacket<EndPoint>>& output_packets,
+        TransportRc& transport_rc)
+{
+    size_t sent;
+    {
+        std::lock_guard<std::mutex> lock(send_mtx_);
+        sent = send_messages(output_packets, transport_rc);
+    }
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < sent; ++i)
+    {
+        if (std::chrono::steady_clock::time_point() != output_packets[i].timestamp)
+        {
+            latency_.record(now - output_packets[i].timestamp);
         }
     }
+    output_packets.erase(output_packets.begin(), output_packets.begin() + std::ptrdiff_t(sent));
+    return output_packets.empty();
+}
+
+template<typename EndPoint>
+size_t Server<EndPoint>::send_messages(
+        std::vector<OutputPacket<EndPoint>>& output_packets,
+        TransportRc& transport_rc)
+{
+    size_t sent = 0;
+    while ((sent < output_packets.size()) && send_message(output_packets[sent], transport_rc))
+    {
+        ++sent;
+    }
+    return sent;
+}
+
+template<typename EndPoint>
+size_t Server<EndPoint>::get_processing_worker(
+        const InputPacket<EndPoint>& input_packet) const
+{
+    if (1 == input_schedulers_.size())
+    {
+        return 0;
+    }
+
+    /* Sessions without client key in the header are identified by the source endpoint. */
+    const dds::xrce::MessageHeader& header = input_packet.message->get_header();
+    size_t hash = has_session_client_key(header.session_id())
+        ? mix_hash(conversion::clientkey_to_raw(header.client_key()))
+        : endpoint_hash(input_packet.source);
+    return hash % input_schedulers_.size();
 }
 
 template<typename EndPoint>
 void Server<EndPoint>::heartbeat_loop()
 {
+    utils::configure_current_thread(ThreadKind::HEARTBEAT, "uxr-hb");
     while (running_cond_)
     {
         processor_->check_heartbeats();
-        std::this_thread::sleep_for(std::chrono::milliseconds(HEARTBEAT_PERIOD));
+        std::this_thread::sleep_for(get_timer_period());
+    }
+}
+
+template<typename EndPoint>
+std::chrono::milliseconds Server<EndPoint>::get_timer_period() const
+{
+    /* Heartbeat deadlines are checked a few times per period, only expired timers do any work. */
+    std::chrono::milliseconds period(std::max<std::chrono::milliseconds::rep>(heartbeat_period_.count() / 4, 1));
+    for (const std::chrono::milliseconds& delay : {aggregation_budget_, acknack_max_delay_})
+    {
+        if ((0 < delay.count()) && (delay < period))
+        {
+            period = delay;
+        }
     }
+    return period;
 }
 
 template<typename EndPoint>
 void Server<EndPoint>::error_handler_loop()
 {
+    utils::configure_current_thread(ThreadKind::AUXILIARY, "uxr-err");
     while (running_cond_)
     {
         std::unique_lock<std::mutex> lock(error_mtx_);
@@ -14,6 +14,7 @@
 
 #include <uxr/agent/transport/discovery/DiscoveryServer.hpp>
 #include <uxr/agent/processor/Processor.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
 
 #include <functional>
 
@@ -55,6 +56,7 @@ bool DiscoveryServer<EndPoint>::stop()
 template<typename EndPoint>
 void DiscoveryServer<EndPoint>::discovery_loop()
 {
+    utils::configure_current_thread(ThreadKind::DISCOVERY, "uxr-disc");
     InputPacket<IPv4EndPoint> input_packet;
     OutputPacket<IPv4EndPoint> output_packet;
     while (running_cond_)
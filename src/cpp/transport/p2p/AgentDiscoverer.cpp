@@ -14,6 +14,7 @@
 
 #include <uxr/agent/transport/p2p/AgentDiscoverer.hpp>
 #include <uxr/agent/p2p/InternalClientManager.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
 
 namespace eprosima {
 namespace uxr {
@@ -63,6 +64,8 @@ bool AgentDiscoverer::stop()
 
 void AgentDiscoverer::loop()
 {
+    utils::configure_current_thread(ThreadKind::AUXILIARY, "uxr-p2p");
+
     /* Header. */
     dds::xrce::MessageHeader header;
     header.session_id(dds::xrce::SESSIONID_NONE_WITHOUT_CLIENT_KEY);
@@ -16,6 +16,7 @@
 #include <uxr/agent/transport/util/InterfaceWindows.hpp>
 #include <uxr/agent/utils/Conversion.hpp>
 #include <uxr/agent/logger/Logger.hpp>
+#include <uxr/agent/utils/ThreadSettings.hpp>
 
 #include <string.h>
 
@@ -411,7 +412,7 @@ bool TCPv4Agent::read_message(
                     if (0 < bytes_read)
                     {
                         InputPacket<IPv4EndPoint> input_packet;
-                        input_packet.message.reset(new InputMessage(conn.input_buffer.buffer.data(), bytes_read));
+                        input_packet.message.reset(conn.input_buffer.take_message(bytes_read));
                         input_packet.source = conn.endpoint;
                         messages_queue_.push(std::move(input_packet));
                         rv = true;
@@ -440,6 +441,7 @@ bool TCPv4Agent::read_message(
 
 void TCPv4Agent::listener_loop()
 {
+    utils::configure_current_thread(ThreadKind::AUXILIARY, "uxr-tcp");
     while (running_cond_)
     {
         int poll_rv = WSAPoll(&listener_poll_, 1, 100);
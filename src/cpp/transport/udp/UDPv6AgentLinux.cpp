@@ -28,6 +28,9 @@
 namespace eprosima {
 namespace uxr {
 
+/* The least recently heard clients are forgotten beyond this number, and learnt again from their next datagram. */
+const size_t MAX_OWNED_ENDPOINTS = 4096;
+
 #ifdef UAGENT_DISCOVERY_PROFILE
 extern template class DiscoveryServer<IPv6EndPoint>; // Explicit instantiation declaration.
 extern template class DiscoveryServerLinux<IPv6EndPoint>; // Explicit instantiation declaration.
@@ -37,8 +40,12 @@ UDPv6Agent::UDPv6Agent(
         uint16_t agent_port,
         Middleware::Kind middleware_kind)
     : Server<IPv6EndPoint>{middleware_kind}
-    , poll_fd_{-1, 0, 0}
-    , buffer_{0}
+    , receivers_()
+    , owners_(MAX_OWNED_ENDPOINTS)
+    , send_iovecs_()
+    , send_addrs_()
+    , send_msgs_()
+    , send_owners_()
     , agent_port_{agent_port}
 #ifdef UAGENT_DISCOVERY_PROFILE
     , discovery_server_{*processor_}
@@ -62,48 +69,101 @@ UDPv6Agent::~UDPv6Agent()
 
 bool UDPv6Agent::init()
 {
-    bool rv = false;
-
-    poll_fd_.fd = socket(PF_INET6, SOCK_DGRAM, 0);
+    bool rv = true;
 
-    if (-1 != poll_fd_.fd)
+    /* One socket per receiver thread, sharing the port if there are several of them,
+     * each one with its reception buffers. */
+    const size_t receiver_count = get_receiver_threads();
+    const size_t recv_batch_size = get_recv_batch_size();
+    if ((receivers_.size() != receiver_count) || (receivers_.front().msgs.size() != recv_batch_size))
     {
-        struct sockaddr_in6 address{};
+        receivers_.clear();
+        receivers_.resize(receiver_count);
+        for (Receiver& receiver : receivers_)
+        {
+            receiver.poll_fd = pollfd{-1, 0, 0};
+            receiver.buffers.resize(recv_batch_size);
+            receiver.overflow.assign(recv_batch_size * SERVER_BUFFER_SIZE, 0);
+            receiver.iovecs.resize(2 * recv_batch_size);
+            receiver.addrs.resize(recv_batch_size);
+            receiver.msgs.resize(recv_batch_size);
+            for (size_t i = 0; i < recv_batch_size; ++i)
+            {
+                receiver.buffers[i] = InputMessage::get_buffer_pool().acquire();
+                receiver.iovecs[2 * i].iov_base = receiver.buffers[i].data();
+                receiver.iovecs[2 * i].iov_len = INPUT_BUFFER_SIZE;
+                receiver.iovecs[2 * i + 1].iov_base = &receiver.overflow[i * SERVER_BUFFER_SIZE + INPUT_BUFFER_SIZE];
+                receiver.iovecs[2 * i + 1].iov_len = SERVER_BUFFER_SIZE - INPUT_BUFFER_SIZE;
+                memset(&receiver.msgs[i], 0, sizeof(struct mmsghdr));
+                receiver.msgs[i].msg_hdr.msg_name = &receiver.addrs[i];
+                receiver.msgs[i].msg_hdr.msg_iov = &receiver.iovecs[2 * i];
+                receiver.msgs[i].msg_hdr.msg_iovlen = 2;
+            }
+        }
+    }
 
-        memset(&address, 0, sizeof(address));
-        address.sin6_family = AF_INET6;
-        address.sin6_addr = in6addr_any;
-        address.sin6_port = htons(uint16_t(agent_port_));
+    for (size_t i = 0; rv && (i < receivers_.size()); ++i)
+    {
+        Receiver& receiver = receivers_[i];
+        receiver.count = 0;
+        receiver.index = 0;
+        receiver.poll_fd.fd = socket(PF_INET6, SOCK_DGRAM, 0);
+        rv = false;
 
-        if (-1 != bind(poll_fd_.fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
+        if (-1 != receiver.poll_fd.fd)
         {
-            poll_fd_.events = POLLIN;
-            rv = true;
+            int reuse_port = 1;
+            if ((1 < receivers_.size()) &&
+                (-1 == setsockopt(receiver.poll_fd.fd, SOL_SOCKET, SO_REUSEPORT, &reuse_port, sizeof(reuse_port))))
+            {
+                UXR_AGENT_LOG_ERROR(
+                    UXR_DECORATE_RED("setsockopt error"),
+                    "port: {}, errno: {}",
+                    agent_port_, errno);
+            }
+            else
+            {
+                struct sockaddr_in6 address{};
 
-            UXR_AGENT_LOG_DEBUG(
-                UXR_DECORATE_GREEN("port opened"),
-                "port: {}",
-                agent_port_);
+                memset(&address, 0, sizeof(address));
+                address.sin6_family = AF_INET6;
+                address.sin6_addr = in6addr_any;
+                address.sin6_port = htons(uint16_t(agent_port_));
 
-            UXR_AGENT_LOG_INFO(
-                UXR_DECORATE_GREEN("running..."),
-                "port: {}",
-                agent_port_);
+                if (-1 != bind(receiver.poll_fd.fd, reinterpret_cast<struct sockaddr*>(&address), sizeof(address)))
+                {
+                    receiver.poll_fd.events = POLLIN;
+                    rv = true;
+
+                    UXR_AGENT_LOG_DEBUG(
+                        UXR_DECORATE_GREEN("port opened"),
+                        "port: {}, socket: {}",
+                        agent_port_, i);
+                }
+                else
+                {
+                    UXR_AGENT_LOG_ERROR(
+                        UXR_DECORATE_RED("bind error"),
+                        "port: {}, errno: {}",
+                        agent_port_, errno);
+                }
+            }
         }
         else
         {
             UXR_AGENT_LOG_ERROR(
-                UXR_DECORATE_RED("bind error"),
+                UXR_DECORATE_RED("socket error"),
                 "port: {}, errno: {}",
                 agent_port_, errno);
         }
     }
-    else
+
+    if (rv)
     {
-        UXR_AGENT_LOG_ERROR(
-            UXR_DECORATE_RED("socket error"),
-            "port: {}, errno: {}",
-            agent_port_, errno);
+        UXR_AGENT_LOG_INFO(
+            UXR_DECORATE_GREEN("running..."),
+            "port: {}",
+            agent_port_);
     }
 
     return rv;
@@ -111,28 +171,37 @@ bool UDPv6Agent::init()
 
 bool UDPv6Agent::fini()
 {
-    if (-1 == poll_fd_.fd)
+    bool rv = true;
+    bool closed = false;
+    for (Receiver& receiver : receivers_)
     {
-        return true;
+        if (-1 != receiver.poll_fd.fd)
+        {
+            if (0 == ::close(receiver.poll_fd.fd))
+            {
+                receiver.poll_fd.fd = -1;
+                closed = true;
+            }
+            else
+            {
+                rv = false;
+                UXR_AGENT_LOG_ERROR(
+                    UXR_DECORATE_RED("socket error"),
+                    "port: {}, errno: {}",
+                    agent_port_, errno);
+            }
+        }
     }
 
-    bool rv = false;
-    if (0 == ::close(poll_fd_.fd))
+    if (closed && rv)
     {
-        poll_fd_.fd = -1;
-        rv = true;
         UXR_AGENT_LOG_INFO(
             UXR_DECORATE_GREEN("server stopped"),
             "port: {}",
             agent_port_);
     }
-    else
-    {
-        UXR_AGENT_LOG_ERROR(
-            UXR_DECORATE_RED("socket error"),
-            "port: {}, errno: {}",
-            agent_port_, errno);
-    }
+
+    owners_.clear();
     return rv;
 }
 
@@ -169,46 +238,92 @@ bool UDPv6Agent::recv_message(
         InputPacket<IPv6EndPoint>& input_packet,
         int timeout,
         TransportRc& transport_rc)
+{
+    return recv_message_from(0, input_packet, timeout, transport_rc);
+}
+
+bool UDPv6Agent::recv_message_from(
+        size_t receiver_id,
+        InputPacket<IPv6EndPoint>& input_packet,
+        int timeout,
+        TransportRc& transport_rc)
 {
     bool rv = false;
-    struct sockaddr_in6 client_addr{};
-    socklen_t client_addr_len = sizeof(struct sockaddr_in6);
+    Receiver& receiver = receivers_[receiver_id];
 
-    int poll_rv = poll(&poll_fd_, 1, timeout);
-    if (0 < poll_rv)
+    /* Once the previous batch is handed out, wait for the next one. */
+    if (receiver.index == receiver.count)
     {
-        ssize_t bytes_received =
-            recvfrom(
-                poll_fd_.fd,
-                buffer_,
-                sizeof(buffer_),
-                0,
-                reinterpret_cast<sockaddr*>(&client_addr),
-                &client_addr_len);
-        if (-1 != bytes_received)
+        receiver.index = 0;
+        receiver.count = 0;
+        int poll_rv = poll(&receiver.poll_fd, 1, timeout);
+        if (0 < poll_rv)
         {
-            input_packet.message.reset(new InputMessage(buffer_, size_t(bytes_received)));
-            std::array<uint8_t, 16> addr{};
-            std::copy(std::begin(client_addr.sin6_addr.s6_addr), std::end(client_addr.sin6_addr.s6_addr), addr.begin());
-            input_packet.source = IPv6EndPoint(addr, client_addr.sin6_port);
-            rv = true;
-
-            uint32_t raw_client_key = 0u;
-            Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
-            UXR_AGENT_LOG_MESSAGE(
-                UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
-                raw_client_key,
-                input_packet.message->get_buf(),
-                input_packet.message->get_len());
+            for (struct mmsghdr& msg : receiver.msgs)
+            {
+                msg.msg_hdr.msg_namelen = sizeof(struct sockaddr_in6);
+            }
+            int messages_received =
+                recvmmsg(
+                    receiver.poll_fd.fd,
+                    receiver.msgs.data(),
+                    unsigned(receiver.msgs.size()),
+                    MSG_DONTWAIT,
+                    nullptr);
+            if (0 < messages_received)
+            {
+                receiver.count = size_t(messages_received);
+                account_recv_syscall(receiver.count);
+            }
+            else
+            {
+                transport_rc = ((EAGAIN == errno) || (EWOULDBLOCK == errno))
+                    ? TransportRc::timeout_error
+                    : TransportRc::server_error;
+            }
         }
         else
         {
-            transport_rc = TransportRc::server_error;
+            transport_rc = (0 == poll_rv) ? TransportRc::timeout_error : TransportRc::server_error;
         }
     }
-    else
+
+    if (receiver.index < receiver.count)
     {
-        transport_rc = (0 == poll_rv) ? TransportRc::timeout_error : TransportRc::server_error;
+        const size_t i = receiver.index;
+        const size_t len = receiver.msgs[i].msg_len;
+        const struct sockaddr_in6& client_addr = receiver.addrs[i];
+        if (len <= INPUT_BUFFER_SIZE)
+        {
+            /* The message takes the buffer, which is replaced for the next batch. */
+            input_packet.message.reset(new InputMessage(std::move(receiver.buffers[i]), len));
+            receiver.buffers[i] = InputMessage::get_buffer_pool().acquire();
+            receiver.iovecs[2 * i].iov_base = receiver.buffers[i].data();
+        }
+        else
+        {
+            uint8_t* datagram = &receiver.overflow[i * SERVER_BUFFER_SIZE];
+            memcpy(datagram, receiver.buffers[i].data(), INPUT_BUFFER_SIZE);
+            input_packet.message.reset(new InputMessage(datagram, len));
+        }
+        std::array<uint8_t, 16> addr{};
+        std::copy(std::begin(client_addr.sin6_addr.s6_addr), std::end(client_addr.sin6_addr.s6_addr), addr.begin());
+        input_packet.source = IPv6EndPoint(addr, client_addr.sin6_port);
+        ++receiver.index;
+        rv = true;
+
+        if (1 < receivers_.size())
+        {
+            set_owner(input_packet.source, receiver_id);
+        }
+
+        uint32_t raw_client_key = 0u;
+        Server<IPv6EndPoint>::get_client_key(input_packet.source, raw_client_key);
+        UXR_AGENT_LOG_MESSAGE(
+            UXR_DECORATE_YELLOW("[==>> UDP <<==]"),
+            raw_client_key,
+            input_packet.message->get_buf(),
+            input_packet.message->get_len());
     }
 
     return rv;
@@ -229,7 +344,7 @@ bool UDPv6Agent::send_message(
 
     ssize_t bytes_sent =
         sendto(
-            poll_fd_.fd,
+            receivers_[get_owner(output_packet.destination)].poll_fd.fd,
             output_packet.message->get_buf(),
             output_packet.message->get_len(),
             0,
@@ -237,6 +352,7 @@ bool UDPv6Agent::send_message(
             sizeof(client_addr));
     if (-1 != bytes_sent)
     {
+        account_send_syscall(1);
         if (size_t(bytes_sent) == output_packet.message->get_len())
         {
             rv = true;
@@ -253,11 +369,108 @@ bool UDPv6Agent::send_message(
     {
         transport_rc = TransportRc::server_error;
     }
-    
 
     return rv;
 }
 
+size_t UDPv6Agent::send_messages(
+        std::vector<OutputPacket<IPv6EndPoint>>& output_packets,
+        TransportRc& transport_rc)
+{
+    const size_t count = output_packets.size();
+    if (send_msgs_.size() < count)
+    {
+        send_iovecs_.resize(count);
+        send_addrs_.resize(count);
+        send_msgs_.resize(count);
+        send_owners_.resize(count);
+    }
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        const OutputPacket<IPv6EndPoint>& output_packet = output_packets[i];
+        struct sockaddr_in6& client_addr = send_addrs_[i];
+        memset(&client_addr, 0, sizeof(client_addr));
+        client_addr.sin6_family = AF_INET6;
+        client_addr.sin6_port = output_packet.destination.get_port();
+        const std::array<uint8_t, 16>& destination = output_packet.destination.get_addr();
+        std::copy(destination.begin(), destination.end(), std::begin(client_addr.sin6_addr.s6_addr));
+
+        send_iovecs_[i].iov_base = output_packet.message->get_buf();
+        send_iovecs_[i].iov_len = output_packet.message->get_len();
+        memset(&send_msgs_[i], 0, sizeof(struct mmsghdr));
+        send_msgs_[i].msg_hdr.msg_name = &client_addr;
+        send_msgs_[i].msg_hdr.msg_namelen = sizeof(client_addr);
+        send_msgs_[i].msg_hdr.msg_iov = &send_iovecs_[i];
+        send_msgs_[i].msg_hdr.msg_iovlen = 1;
+        send_owners_[i] = get_owner(output_packet.destination);
+    }
+
+    /* Consecutive packets reached through the same socket go in the same call. The kernel may
+     * send only part of them, the rest is resubmitted. */
+    size_t sent = 0;
+    bool sending = true;
+    while (sending && (sent < count))
+    {
+        size_t run_end = sent + 1;
+        while ((run_end < count) && (send_owners_[run_end] == send_owners_[sent]))
+        {
+            ++run_end;
+        }
+
+        int messages_sent =
+            sendmmsg(
+                receivers_[send_owners_[sent]].poll_fd.fd,
+                &send_msgs_[sent],
+                unsigned(run_end - sent),
+                0);
+        if (0 < messages_sent)
+        {
+            account_send_syscall(size_t(messages_sent));
+            const size_t last = sent + size_t(messages_sent);
+            while (sending && (sent < last))
+            {
+                const OutputPacket<IPv6EndPoint>& output_packet = output_packets[sent];
+                if (send_msgs_[sent].msg_len == output_packet.message->get_len())
+                {
+                    uint32_t raw_client_key = 0u;
+                    Server<IPv6EndPoint>::get_client_key(output_packet.destination, raw_client_key);
+                    UXR_AGENT_LOG_MESSAGE(
+                        UXR_DECORATE_YELLOW("[** <<UDP>> **]"),
+                        raw_client_key,
+                        output_packet.message->get_buf(),
+                        output_packet.message->get_len());
+                    ++sent;
+                }
+                else
+                {
+                    sending = false;
+                }
+            }
+        }
+        else
+        {
+            transport_rc = TransportRc::server_error;
+            sending = false;
+        }
+    }
+
+    return sent;
+}
+
+size_t UDPv6Agent::get_owner(
+        const IPv6EndPoint& endpoint)
+{
+    return (1 < receivers_.size()) ? owners_.get(endpoint) : 0;
+}
+
+void UDPv6Agent::set_owner(
+        const IPv6EndPoint& endpoint,
+        size_t receiver_id)
+{
+    owners_.set(endpoint, receiver_id);
+}
+
 bool UDPv6Agent::handle_error(
         TransportRc /*transport_rc*/)
 {
@@ -89,4 +89,181 @@ eprosima::uxr::Middleware::Kind eprosima::uxr::agent::parser::utils::get_mw_kind
     return eprosima::uxr::Middleware::Kind::NONE;
 }
 
+eprosima::uxr::SchedulerKind eprosima::uxr::agent::parser::utils::get_scheduler_kind(
+        const std::string& kind)
+{
+    if ("ring" == kind)
+    {
+        return eprosima::uxr::SchedulerKind::RING;
+    }
+    if ("priority" == kind)
+    {
+        return eprosima::uxr::SchedulerKind::PRIORITY;
+    }
+    if ("drr" == kind)
+    {
+        return eprosima::uxr::SchedulerKind::DRR;
+    }
+    return eprosima::uxr::SchedulerKind::FCFS;
+}
+
+eprosima::uxr::OverflowPolicy eprosima::uxr::agent::parser::utils::get_overflow_policy(
+        const std::string& policy)
+{
+    if ("drop-newest" == policy)
+    {
+        return eprosima::uxr::OverflowPolicy::DROP_NEWEST;
+    }
+    if ("drop-best-effort" == policy)
+    {
+        return eprosima::uxr::OverflowPolicy::DROP_OLDEST_BEST_EFFORT;
+    }
+    if ("reject-by-class" == policy)
+    {
+        return eprosima::uxr::OverflowPolicy::REJECT_BY_CLASS;
+    }
+    if ("block" == policy)
+    {
+        return eprosima::uxr::OverflowPolicy::BLOCK;
+    }
+    return eprosima::uxr::OverflowPolicy::DROP_OLDEST;
+}
+
+eprosima::uxr::ExecutionMode eprosima::uxr::agent::parser::utils::get_execution_mode(
+        const std::string& mode)
+{
+    if ("event-loop" == mode)
+    {
+        return eprosima::uxr::ExecutionMode::EVENT_LOOP;
+    }
+    return eprosima::uxr::ExecutionMode::THREADED;
+}
+
+namespace {
+
+/* Splits a string by the given separator, skipping the empty tokens. */
+std::vector<std::string> split(
+        const std::string& str,
+        char separator)
+{
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    while (std::getline(ss, token, separator))
+    {
+        if (!token.empty())
+        {
+            tokens.push_back(token);
+        }
+    }
+    return tokens;
+}
+
+bool parse_number(
+        const std::string& str,
+        unsigned long max_value,
+        unsigned long& value)
+{
+    bool rv = false;
+    if (!str.empty() && std::all_of(str.begin(), str.end(), ::isdigit) && (str.size() < 6))
+    {
+        value = std::stoul(str);
+        rv = (value <= max_value);
+    }
+    return rv;
+}
+
+/* Parses a list of CPUs such as "0-3,6". */
+bool parse_cpus(
+        const std::string& str,
+        std::vector<uint16_t>& cpus)
+{
+    cpus.clear();
+    for (const std::string& range : split(str, ','))
+    {
+        size_t dash = range.find('-');
+        unsigned long first;
+        unsigned long last;
+        if (!parse_number(range.substr(0, dash), 1023, first) ||
+            !parse_number((std::string::npos == dash) ? range : range.substr(dash + 1), 1023, last) ||
+            (last < first))
+        {
+            return false;
+        }
+        for (unsigned long cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(uint16_t(cpu));
+        }
+    }
+    return !cpus.empty();
+}
+
+/* Applies the value of each <kind>=<value> entry to the settings of that kind, or all of them. */
+template<typename F>
+bool parse_thread_entries(
+        const std::string& str,
+        F&& apply)
+{
+    static const std::map<std::string, eprosima::uxr::ThreadKind> kinds = {
+        {"recv", eprosima::uxr::ThreadKind::RECEIVER},
+        {"proc", eprosima::uxr::ThreadKind::PROCESSING},
+        {"send", eprosima::uxr::ThreadKind::SENDER},
+        {"hb", eprosima::uxr::ThreadKind::HEARTBEAT},
+        {"rd", eprosima::uxr::ThreadKind::READER},
+        {"disc", eprosima::uxr::ThreadKind::DISCOVERY},
+        {"aux", eprosima::uxr::ThreadKind::AUXILIARY}};
+
+    for (const std::string& entry : split(str, ':'))
+    {
+        size_t equal = entry.find('=');
+        if (std::string::npos == equal)
+        {
+            return false;
+        }
+        const std::string kind = entry.substr(0, equal);
+        const std::string value = entry.substr(equal + 1);
+        if ("all" == kind)
+        {
+            for (size_t i = 0; i < eprosima::uxr::THREAD_KIND_COUNT; ++i)
+            {
+                if (!apply(i, value))
+                {
+                    return false;
+                }
+            }
+        }
+        else
+        {
+            auto it = kinds.find(kind);
+            if ((kinds.end() == it) || !apply(size_t(it->second), value))
+            {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool eprosima::uxr::agent::parser::utils::get_thread_settings(
+        const std::string& affinity,
+        const std::string& priority,
+        std::array<eprosima::uxr::ThreadSettings, eprosima::uxr::THREAD_KIND_COUNT>& settings)
+{
+    settings.fill(eprosima::uxr::ThreadSettings{});
+    return
+        parse_thread_entries(affinity, [&](size_t kind, const std::string& value)
+        {
+            return parse_cpus(value, settings[kind].cpus);
+        }) &&
+        parse_thread_entries(priority, [&](size_t kind, const std::string& value)
+        {
+            unsigned long number = 0;
+            bool rv = parse_number(value, 99, number);
+            settings[kind].priority = uint8_t(number);
+            return rv;
+        });
+}
+
 #endif // UXR_AGENT_UTILS_ARGUMENTPARSER_CPP_
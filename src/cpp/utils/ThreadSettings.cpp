@@ -0,0 +1,117 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/ThreadSettings.hpp>
+#include <uxr/agent/logger/Logger.hpp>
+
+#include <array>
+#include <mutex>
+
+#ifndef _WIN32
+#include <pthread.h>
+#include <sched.h>
+#include <cstring>
+#endif // _WIN32
+
+namespace eprosima {
+namespace uxr {
+namespace utils {
+
+namespace {
+
+std::mutex settings_mtx;
+std::array<ThreadSettings, THREAD_KIND_COUNT> settings_by_kind{};
+
+} // namespace
+
+bool set_thread_settings(
+        ThreadKind kind,
+        const ThreadSettings& settings)
+{
+    bool rv = false;
+    if ((size_t(kind) < THREAD_KIND_COUNT) && (settings.priority < 100))
+    {
+        std::lock_guard<std::mutex> lock(settings_mtx);
+        settings_by_kind[size_t(kind)] = settings;
+        rv = true;
+    }
+    return rv;
+}
+
+ThreadSettings get_thread_settings(
+        ThreadKind kind)
+{
+    ThreadSettings settings{};
+    if (size_t(kind) < THREAD_KIND_COUNT)
+    {
+        std::lock_guard<std::mutex> lock(settings_mtx);
+        settings = settings_by_kind[size_t(kind)];
+    }
+    return settings;
+}
+
+bool configure_current_thread(
+        ThreadKind kind,
+        const std::string& name)
+{
+    bool rv = true;
+#ifndef _WIN32
+    const ThreadSettings settings = get_thread_settings(kind);
+
+    pthread_setname_np(pthread_self(), name.substr(0, 15).c_str());
+
+    if (!settings.cpus.empty())
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        for (uint16_t cpu : settings.cpus)
+        {
+            CPU_SET(cpu, &cpu_set);
+        }
+        int errcode = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        if (0 != errcode)
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("CPU affinity not set"),
+                "thread: {}, errno: {}",
+                name, errcode);
+            rv = false;
+        }
+    }
+
+    if (0 != settings.priority)
+    {
+        struct sched_param param;
+        std::memset(&param, 0, sizeof(param));
+        param.sched_priority = settings.priority;
+        int errcode = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (0 != errcode)
+        {
+            UXR_AGENT_LOG_WARN(
+                UXR_DECORATE_YELLOW("SCHED_FIFO priority not set"),
+                "thread: {}, errno: {}",
+                name, errcode);
+            rv = false;
+        }
+    }
+#else
+    (void) kind;
+    (void) name;
+#endif // _WIN32
+    return rv;
+}
+
+} // namespace utils
+} // namespace uxr
+} // namespace eprosima
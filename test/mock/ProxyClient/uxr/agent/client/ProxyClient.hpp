@@ -32,7 +32,11 @@ public:
     explicit ProxyClient(
         const dds::xrce::CLIENT_Representation& /*representation*/,
         Middleware::Kind /*middleware_kind*/,
-        std::unordered_map<std::string, std::string>&& properties = {}) {};
+        std::unordered_map<std::string, std::string>&& properties = {},
+        const StreamDepths& /*stream_depths*/ = StreamDepths{},
+        uint16_t /*max_stream_depth*/ = DEFAULT_MAX_CLIENT_STREAM_DEPTH)
+        : released_(false)
+    {};
 
     ~ProxyClient() = default;
 
@@ -44,7 +48,12 @@ public:
     MOCK_METHOD0(get_session_id, dds::xrce::SessionId());
     MOCK_METHOD0(session, Session&());
 
-    void release() {}
+    void release() { released_ = true; }
+
+    bool is_released() const { return released_; }
+
+private:
+    bool released_;
 };
 
 } // namespace uxr
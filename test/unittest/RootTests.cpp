@@ -121,6 +121,60 @@ TEST_F(RootTests, DeleteNoExistingClient)
     ASSERT_EQ(dds::xrce::STATUS_ERR_UNKNOWN_REFERENCE, response.status());
 }
 
+TEST_F(RootTests, ClientSnapshots)
+{
+    dds::xrce::CREATE_CLIENT_Payload create_data = generate_create_client_payload();
+    dds::xrce::AGENT_Representation agent_representation;
+    dds::xrce::ResultStatus response = root_.create_client(
+                create_data.client_representation(),
+                agent_representation,
+                Middleware::Kind::FAST);
+    ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+
+    std::shared_ptr<ProxyClient> client = root_.get_client(client_key);
+    ASSERT_TRUE(client != nullptr);
+
+    /* Every pass of get_next_client ends with a call which returns false. */
+    std::shared_ptr<ProxyClient> next_client;
+    ASSERT_TRUE(root_.get_next_client(next_client));
+    ASSERT_EQ(client, next_client);
+
+    response = root_.delete_client(client_key);
+    ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+    ASSERT_TRUE(root_.get_client(client_key) == nullptr);
+    ASSERT_FALSE(root_.get_next_client(next_client));
+    ASSERT_FALSE(root_.get_next_client(next_client));
+}
+
+TEST_F(RootTests, ReconnectClient)
+{
+    dds::xrce::CREATE_CLIENT_Payload create_data = generate_create_client_payload();
+    create_data.client_representation().session_id(0x81);
+    dds::xrce::AGENT_Representation agent_representation;
+    dds::xrce::ResultStatus response = root_.create_client(
+                create_data.client_representation(),
+                agent_representation,
+                Middleware::Kind::FAST);
+    ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+
+    std::shared_ptr<ProxyClient> old_client = root_.get_client(client_key);
+    ASSERT_TRUE(old_client != nullptr);
+    EXPECT_CALL(*old_client, get_session_id()).WillRepeatedly(::testing::Return(dds::xrce::SessionId(0x82)));
+
+    /* A new session replaces the client, whose objects are released at once. */
+    response = root_.create_client(
+                create_data.client_representation(),
+                agent_representation,
+                Middleware::Kind::FAST);
+    ASSERT_EQ(dds::xrce::STATUS_OK, response.status());
+
+    std::shared_ptr<ProxyClient> new_client = root_.get_client(client_key);
+    ASSERT_TRUE(new_client != nullptr);
+    ASSERT_NE(old_client, new_client);
+    ASSERT_TRUE(old_client->is_released());
+    ASSERT_FALSE(new_client->is_released());
+}
+
 /*
 class ProxyClientTests : public CommonData, public ::testing::Test
 {
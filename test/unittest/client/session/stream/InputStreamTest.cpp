@@ -14,6 +14,7 @@
 
 
 #include <uxr/agent/client/session/stream/InputStream.hpp>
+#include <uxr/agent/client/session/stream/StreamTable.hpp>
 #include <map>
 #include <queue>
 #include <mutex>
@@ -299,6 +300,43 @@ TEST_F(ReliableInputStreamTest, UpdateFromHeartbeat)
     ASSERT_TRUE (reliable_stream_.emplace_message(0x0001, buf, sizeof(buf)));
 }
 
+TEST_F(ReliableInputStreamTest, SlidingWindow)
+{
+    uint8_t buf[128] = {0};
+    InputMessagePtr input_message;
+    dds::xrce::ACKNACK_Payload acknack;
+
+    /* Slide the window across the sequence number wrap, around the ring several times. */
+    reliable_stream_.update_from_heartbeat(0x7000, 0x7000);
+    reliable_stream_.update_from_heartbeat(0xE000, 0xE000);
+    reliable_stream_.update_from_heartbeat(0xFFF0, 0xFFF0);
+    for (uint16_t i = 0; i < 4 * RELIABLE_STREAM_DEPTH; i += 2)
+    {
+        const SeqNum seq_num = SeqNum(0xFFF0) + i;
+        ASSERT_TRUE(reliable_stream_.emplace_message(seq_num + 1, buf, sizeof(buf)));
+        ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+        ASSERT_TRUE(reliable_stream_.emplace_message(seq_num, buf, sizeof(buf)));
+        ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+        ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+        ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+    }
+
+    /* Messages skipped by a HEARTBEAT are never handled. */
+    const SeqNum next = SeqNum(0xFFF0) + 4 * RELIABLE_STREAM_DEPTH;
+    ASSERT_TRUE(reliable_stream_.emplace_message(next + 1, buf, sizeof(buf)));
+    ASSERT_TRUE(reliable_stream_.emplace_message(next + 3, buf, sizeof(buf)));
+    reliable_stream_.update_from_heartbeat(next + 2, next + 3);
+    reliable_stream_.fill_acknack(acknack);
+    ASSERT_EQ(acknack.first_unacked_seq_num(), uint16_t(next + 2));
+    ASSERT_EQ(acknack.nack_bitmap().at(0), 0x00);
+    ASSERT_EQ(acknack.nack_bitmap().at(1), 0x01);
+    ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+    ASSERT_TRUE(reliable_stream_.emplace_message(next + 2, buf, sizeof(buf)));
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_FALSE(reliable_stream_.pop_message(input_message));
+}
+
 TEST_F(ReliableInputStreamTest, FillAcknack)
 {
     uint8_t buf[128] = {0};
@@ -340,6 +378,90 @@ TEST_F(ReliableInputStreamTest, FillAcknack)
     }
 }
 
+TEST_F(ReliableInputStreamTest, AcknackDue)
+{
+    uint8_t buf[128] = {0};
+    InputMessagePtr input_message;
+    dds::xrce::ACKNACK_Payload acknack;
+
+    /* In-order messages are due once enough of them are received. */
+    for (uint16_t i = 0; i < 3; ++i)
+    {
+        ASSERT_FALSE(reliable_stream_.is_acknack_due(3));
+        reliable_stream_.emplace_message(i, buf, sizeof(buf));
+        ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    }
+    ASSERT_TRUE(reliable_stream_.is_acknack_due(3));
+    ASSERT_TRUE(reliable_stream_.is_acknack_due(1));
+
+    reliable_stream_.fill_acknack(acknack);
+    ASSERT_FALSE(reliable_stream_.is_acknack_due(1));
+
+    /* Gaps are due at once. */
+    reliable_stream_.emplace_message(0x0004, buf, sizeof(buf));
+    reliable_stream_.fill_acknack(acknack);
+    ASSERT_TRUE(reliable_stream_.is_acknack_due(3));
+
+    reliable_stream_.emplace_message(0x0003, buf, sizeof(buf));
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_TRUE(reliable_stream_.pop_message(input_message));
+    ASSERT_FALSE(reliable_stream_.is_acknack_due(3));
+}
+
+TEST(ReliableInputStreamDepthTest, RuntimeDepth)
+{
+    uint8_t buf[128] = {0};
+    InputMessagePtr input_message;
+    const uint16_t depth = 100;
+    ReliableInputStream reliable_stream(depth);
+
+    /* The window spans several bitmap words. */
+    for (uint16_t i = depth; i > 1; --i)
+    {
+        ASSERT_TRUE(reliable_stream.emplace_message(i - 1, buf, sizeof(buf)));
+    }
+    ASSERT_FALSE(reliable_stream.emplace_message(depth, buf, sizeof(buf)));
+    ASSERT_FALSE(reliable_stream.pop_message(input_message));
+    ASSERT_TRUE(reliable_stream.emplace_message(0, buf, sizeof(buf)));
+    for (uint16_t i = 0; i < depth; ++i)
+    {
+        ASSERT_TRUE(reliable_stream.pop_message(input_message));
+    }
+    ASSERT_FALSE(reliable_stream.pop_message(input_message));
+
+    /* Skipping beyond the first word keeps the messages received past it. */
+    ASSERT_TRUE(reliable_stream.emplace_message(depth + 70, buf, sizeof(buf)));
+    reliable_stream.update_from_heartbeat(depth + 70, depth + 70);
+    ASSERT_TRUE(reliable_stream.pop_message(input_message));
+    ASSERT_FALSE(reliable_stream.pop_message(input_message));
+}
+
+TEST(BestEffortInputStreamDepthTest, RuntimeDepth)
+{
+    uint8_t buf[128] = {0};
+    BestEffortInputStream best_effort_stream(2);
+
+    ASSERT_TRUE(best_effort_stream.emplace_message(0, buf, sizeof(buf)));
+    ASSERT_TRUE(best_effort_stream.emplace_message(1, buf, sizeof(buf)));
+    ASSERT_FALSE(best_effort_stream.emplace_message(2, buf, sizeof(buf)));
+}
+
+TEST(StreamTableTest, LazyCreation)
+{
+    StreamTable<ReliableInputStream> streams(RELIABLE_STREAM_DEPTH);
+
+    ASSERT_TRUE(nullptr == streams.find(0x80));
+    ReliableInputStream& stream = streams.get(0x80);
+    ASSERT_EQ(streams.find(0x80), &stream);
+    ASSERT_EQ(&streams.get(0x80), &stream);
+    ASSERT_TRUE(nullptr == streams.find(0xFF));
+    ASSERT_NE(&streams.get(0xFF), &stream);
+
+    std::vector<uint8_t> indexes;
+    streams.for_each([&](uint8_t index, ReliableInputStream&) { indexes.push_back(index); });
+    ASSERT_EQ(indexes, (std::vector<uint8_t>{0x00, 0x7F}));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
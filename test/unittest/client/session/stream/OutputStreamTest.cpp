@@ -14,9 +14,12 @@
 
 
 #include <uxr/agent/client/session/stream/OutputStream.hpp>
+#include <uxr/agent/client/session/Session.hpp>
+#include <uxr/agent/utils/TimerWheel.hpp>
 #include <map>
 #include <queue>
 #include <mutex>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -85,6 +88,20 @@ TEST_F(NoneOutputStreamTest, MessageCapacity)
     ASSERT_FALSE(none_stream_.push_submessage(session_info_, dds::xrce::WRITE_DATA, write_data));
 }
 
+/**
+ * @brief   This test checks the size of the messages of the stream.
+ *          Messages shall be allocated for their submessage and not for the whole MTU.
+ */
+TEST_F(NoneOutputStreamTest, MessageSize)
+{
+    dds::xrce::STATUS_Payload status{};
+    ASSERT_TRUE(none_stream_.push_submessage(session_info_, dds::xrce::STATUS, status));
+
+    OutputMessagePtr output_message;
+    ASSERT_TRUE(none_stream_.pop_message(output_message));
+    ASSERT_FALSE(output_message->fits_submessage(0));
+}
+
 /****************************************************************************************
  * Best-Effort Output Stream.
  ****************************************************************************************/
@@ -144,6 +161,66 @@ TEST_F(BestEffortOutputStreamTest, MaximumMessageSize)
     ASSERT_FALSE(best_effort_stream_.push_submessage(session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data));
 }
 
+/**
+ * @brief   This test checks the size of the messages of the stream.
+ *          Only aggregated messages shall be allocated for the whole MTU.
+ */
+TEST_F(BestEffortOutputStreamTest, MessageSize)
+{
+    dds::xrce::STATUS_Payload status{};
+    OutputMessagePtr output_message;
+
+    ASSERT_TRUE(best_effort_stream_.push_submessage(session_info_, stream_id_, dds::xrce::STATUS, status));
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_FALSE(output_message->fits_submessage(0));
+
+    ASSERT_TRUE(best_effort_stream_.push_submessage(session_info_, stream_id_, dds::xrce::STATUS, status, true));
+    ASSERT_TRUE(best_effort_stream_.flush());
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_TRUE(output_message->fits_submessage(0));
+}
+
+/**
+ * @brief   This test checks the aggregation of submessages in the best-effort stream.
+ *          Aggregated submessages shall share a message until it is full or flushed.
+ */
+TEST_F(BestEffortOutputStreamTest, Aggregation)
+{
+    dds::xrce::MessageHeader header{};
+    dds::xrce::SubmessageHeader subheader{};
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().resize(200);
+
+    const size_t header_size = header.getCdrSerializedSize();
+    const size_t submessage_size = subheader.getCdrSerializedSize() + write_data.getCdrSerializedSize();
+
+    OutputMessagePtr output_message;
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(best_effort_stream_.push_submessage(
+            session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data, true));
+    }
+
+    /* The third submessage does not fit in the first message. */
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_EQ(output_message->get_len(), header_size + 2 * submessage_size);
+    ASSERT_FALSE(best_effort_stream_.pop_message(output_message));
+
+    ASSERT_TRUE(best_effort_stream_.flush());
+    ASSERT_FALSE(best_effort_stream_.flush());
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_EQ(output_message->get_len(), header_size + submessage_size);
+
+    /* A submessage which is not aggregated closes the open message. */
+    ASSERT_TRUE(best_effort_stream_.push_submessage(
+        session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data, true));
+    ASSERT_TRUE(best_effort_stream_.push_submessage(
+        session_info_, stream_id_, dds::xrce::WRITE_DATA, write_data));
+    ASSERT_TRUE(best_effort_stream_.pop_message(output_message));
+    ASSERT_EQ(output_message->get_len(), header_size + 2 * submessage_size);
+    ASSERT_FALSE(best_effort_stream_.pop_message(output_message));
+}
+
 /****************************************************************************************
  * Reliable Output Stream.
  ****************************************************************************************/
@@ -193,6 +270,186 @@ TEST_F(ReliableOutputStreamTest, StreamCapacity)
     ASSERT_FALSE(reliable_stream_.get_next_message(output_message));
 }
 
+/**
+ * @brief   This test checks the tracking of unacknowledged messages.
+ *          The stream shall hold unacknowledged messages from a push until they are all acknowledged.
+ */
+TEST_F(ReliableOutputStreamTest, UnackedMessages)
+{
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    ASSERT_FALSE(reliable_stream_.has_unacked_messages());
+
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(reliable_stream_.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA,
+            write_data,
+            std::chrono::milliseconds(500)));
+        ASSERT_TRUE(reliable_stream_.has_unacked_messages());
+    }
+
+    OutputMessagePtr output_message;
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+    ASSERT_FALSE(reliable_stream_.update_from_acknack(1));
+    ASSERT_TRUE(reliable_stream_.has_unacked_messages());
+    ASSERT_TRUE(reliable_stream_.update_from_acknack(2));
+    ASSERT_FALSE(reliable_stream_.has_unacked_messages());
+}
+
+/**
+ * @brief   This test checks that a HEARTBEAT timer survives an ACKNACK which empties the stream
+ *          while another thread pushes a message, following the steps of the processor.
+ */
+TEST(SessionHeartbeatTest, PushDuringAcknack)
+{
+    Session session(SessionInfo{client_key, session_id, mtu});
+    const dds::xrce::StreamId stream_id = dds::xrce::STREAMID_BUILTIN_RELIABLE;
+    const uint64_t key = stream_id;
+    utils::TimerWheel heartbeat_timers;
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    OutputMessagePtr output_message;
+
+    ASSERT_TRUE(session.push_output_submessage(
+        stream_id, dds::xrce::WRITE_DATA, write_data, std::chrono::milliseconds(0)));
+    ASSERT_TRUE(session.get_next_output_message(stream_id, output_message));
+    ASSERT_TRUE(heartbeat_timers.arm(key, 1));
+
+    /* The ACKNACK empties the stream. */
+    ASSERT_TRUE(session.update_from_acknack(stream_id, 1));
+
+    /* A reader pushes before the timer is disarmed, so arming it again does nothing. */
+    ASSERT_TRUE(session.push_output_submessage(
+        stream_id, dds::xrce::WRITE_DATA, write_data, std::chrono::milliseconds(0)));
+    ASSERT_TRUE(session.get_next_output_message(stream_id, output_message));
+    ASSERT_FALSE(heartbeat_timers.arm(key, 1));
+
+    /* The disarm is followed by a check of the stream, which arms the timer again. */
+    ASSERT_TRUE(heartbeat_timers.disarm(key));
+    ASSERT_TRUE(session.has_unacked_messages(stream_id));
+    ASSERT_TRUE(heartbeat_timers.arm(key, 1));
+    ASSERT_TRUE(heartbeat_timers.is_armed(key));
+
+    /* Once everything is acknowledged the timer stays disarmed. */
+    ASSERT_TRUE(session.update_from_acknack(stream_id, 2));
+    ASSERT_TRUE(heartbeat_timers.disarm(key));
+    ASSERT_FALSE(session.has_unacked_messages(stream_id));
+}
+
+/****************************************************************************************
+ * Session Unacknowledged Streams.
+ ****************************************************************************************/
+class SessionUnackedStreamsTest : public ::testing::Test
+{
+public:
+    SessionUnackedStreamsTest()
+        : session_(SessionInfo{client_key, session_id, mtu})
+        , write_data_{}
+    {}
+
+    bool push(
+            dds::xrce::StreamId stream_id,
+            bool aggregate = false)
+    {
+        return session_.push_output_submessage(
+            stream_id, dds::xrce::WRITE_DATA, write_data_, std::chrono::milliseconds(0), aggregate);
+    }
+
+    std::vector<uint8_t> get_unacked_streams() const
+    {
+        std::vector<uint8_t> stream_ids;
+        session_.for_each_unacked_stream([&stream_ids](uint8_t stream_id) { stream_ids.push_back(stream_id); });
+        return stream_ids;
+    }
+
+public:
+    Session session_;
+    dds::xrce::WRITE_DATA_Payload_Data write_data_;
+};
+
+/**
+ * @brief   This test checks that a reliable stream is visited once a message is pushed into it.
+ *          Best-effort streams shall never be visited.
+ */
+TEST_F(SessionUnackedStreamsTest, Push)
+{
+    ASSERT_TRUE(get_unacked_streams().empty());
+
+    ASSERT_TRUE(push(dds::xrce::STREAMID_BUILTIN_BEST_EFFORTS));
+    ASSERT_TRUE(get_unacked_streams().empty());
+
+    ASSERT_TRUE(push(dds::xrce::STREAMID_BUILTIN_RELIABLE));
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({dds::xrce::STREAMID_BUILTIN_RELIABLE}));
+}
+
+/**
+ * @brief   This test checks that a reliable stream is no longer visited once fully acknowledged.
+ */
+TEST_F(SessionUnackedStreamsTest, FullAcknack)
+{
+    const dds::xrce::StreamId stream_id = dds::xrce::STREAMID_BUILTIN_RELIABLE;
+    OutputMessagePtr output_message;
+    for (int i = 0; i < 2; ++i)
+    {
+        ASSERT_TRUE(push(stream_id));
+        ASSERT_TRUE(session_.get_next_output_message(stream_id, output_message));
+    }
+
+    /* A partial ACKNACK keeps the stream. */
+    ASSERT_FALSE(session_.update_from_acknack(stream_id, 1));
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({stream_id}));
+
+    ASSERT_TRUE(session_.update_from_acknack(stream_id, 2));
+    ASSERT_TRUE(get_unacked_streams().empty());
+}
+
+/**
+ * @brief   This test checks that a stream whose only message is still open is cleared by a HEARTBEAT,
+ *          and visited again once the message is flushed.
+ */
+TEST_F(SessionUnackedStreamsTest, FlushAfterHeartbeat)
+{
+    const dds::xrce::StreamId stream_id = dds::xrce::STREAMID_BUILTIN_RELIABLE;
+    dds::xrce::HEARTBEAT_Payload heartbeat;
+    OutputMessagePtr output_message;
+
+    ASSERT_TRUE(push(stream_id, true));
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({stream_id}));
+
+    /* The open message is not sent yet, so there is nothing to announce. */
+    ASSERT_FALSE(session_.fill_heartbeat(stream_id, heartbeat));
+    ASSERT_TRUE(get_unacked_streams().empty());
+
+    ASSERT_TRUE(session_.flush_output_stream(stream_id));
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({stream_id}));
+    ASSERT_TRUE(session_.get_next_output_message(stream_id, output_message));
+    ASSERT_TRUE(session_.fill_heartbeat(stream_id, heartbeat));
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({stream_id}));
+}
+
+/**
+ * @brief   This test checks the streams above 0xBF, kept in the second word of the set.
+ */
+TEST_F(SessionUnackedStreamsTest, HighStreamIds)
+{
+    OutputMessagePtr output_message;
+    for (dds::xrce::StreamId stream_id : {0xFF, 0xBF, 0xC0})
+    {
+        ASSERT_TRUE(push(stream_id));
+        ASSERT_TRUE(session_.get_next_output_message(stream_id, output_message));
+    }
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({0xBF, 0xC0, 0xFF}));
+
+    ASSERT_TRUE(session_.update_from_acknack(0xC0, 1));
+    ASSERT_EQ(get_unacked_streams(), std::vector<uint8_t>({0xBF, 0xFF}));
+
+    ASSERT_TRUE(session_.update_from_acknack(0xFF, 1));
+    ASSERT_TRUE(session_.update_from_acknack(0xBF, 1));
+    ASSERT_TRUE(get_unacked_streams().empty());
+}
+
 /**
  * @brief   This test checks the maximum message size of the stream.
  *          The reliable stream shall be able to push messages larger than the MTU.
@@ -348,6 +605,47 @@ TEST_F(ReliableOutputStreamTest, PushMessages)
     ASSERT_EQ(hearbeat.last_unacked_seq_nr(), expected_last_unacked);
 }
 
+/**
+ * @brief   This test checks the aggregation of submessages in the reliable stream.
+ *          The open message shall take its sequence number only once it is full or flushed.
+ */
+TEST_F(ReliableOutputStreamTest, Aggregation)
+{
+    dds::xrce::MessageHeader header{};
+    dds::xrce::SubmessageHeader subheader{};
+    dds::xrce::WRITE_DATA_Payload_Data write_data{};
+    write_data.data().serialized_data().resize(200);
+
+    const size_t header_size = header.getCdrSerializedSize();
+    const size_t submessage_size = subheader.getCdrSerializedSize() + write_data.getCdrSerializedSize();
+    dds::xrce::HEARTBEAT_Payload hearbeat;
+    OutputMessagePtr output_message;
+
+    for (int i = 0; i < 3; ++i)
+    {
+        ASSERT_TRUE(reliable_stream_.push_submessage(
+            session_info_,
+            stream_id_,
+            dds::xrce::WRITE_DATA, write_data,
+            std::chrono::milliseconds(500),
+            true));
+    }
+
+    /* The third submessage does not fit in the first message. */
+    reliable_stream_.fill_heartbeat(hearbeat);
+    ASSERT_EQ(hearbeat.last_unacked_seq_nr(), 0x0000);
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+    ASSERT_EQ(output_message->get_len(), header_size + 2 * submessage_size);
+    ASSERT_FALSE(reliable_stream_.get_next_message(output_message));
+
+    ASSERT_TRUE(reliable_stream_.flush());
+    ASSERT_FALSE(reliable_stream_.flush());
+    reliable_stream_.fill_heartbeat(hearbeat);
+    ASSERT_EQ(hearbeat.last_unacked_seq_nr(), 0x0001);
+    ASSERT_TRUE(reliable_stream_.get_next_message(output_message));
+    ASSERT_EQ(output_message->get_len(), header_size + submessage_size);
+}
+
 /**
  * @brief   This test checks that the reliable stream is promoted properly when messages are popped.
  *          The first_unacked shall increase by one for each popped message.
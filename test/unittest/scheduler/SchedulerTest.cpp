@@ -0,0 +1,516 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/scheduler/FCFSScheduler.hpp>
+#include <uxr/agent/scheduler/RingScheduler.hpp>
+#include <uxr/agent/scheduler/PriorityScheduler.hpp>
+#include <uxr/agent/scheduler/DRRScheduler.hpp>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class RingSchedulerTest : public ::testing::Test
+{
+protected:
+    RingSchedulerTest()
+        : scheduler_(capacity_)
+    {
+        scheduler_.init();
+    }
+
+    ~RingSchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    static constexpr size_t capacity_ = 8;
+    RingScheduler<uint32_t> scheduler_;
+};
+
+constexpr size_t RingSchedulerTest::capacity_;
+
+TEST_F(RingSchedulerTest, Capacity)
+{
+    ASSERT_EQ(RingScheduler<uint32_t>(8).capacity(), 8u);
+    ASSERT_EQ(RingScheduler<uint32_t>(9).capacity(), 16u);
+    ASSERT_EQ(RingScheduler<uint32_t>(0).capacity(), 2u);
+}
+
+TEST_F(RingSchedulerTest, FirstComeFirstServed)
+{
+    for (uint32_t i = 0; i < capacity_; ++i)
+    {
+        scheduler_.push(uint32_t(i), 0);
+    }
+
+    uint32_t element;
+    for (uint32_t i = 0; i < capacity_; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, i);
+    }
+}
+
+/*
+ * @brief The oldest element is discarded when the ring is full.
+ */
+TEST_F(RingSchedulerTest, Overflow)
+{
+    for (uint32_t i = 0; i < capacity_ + 2; ++i)
+    {
+        scheduler_.push(uint32_t(i), 0);
+    }
+
+    uint32_t element;
+    for (uint32_t i = 2; i < capacity_ + 2; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, i);
+    }
+}
+
+/*
+ * @brief A consumer parked on an empty ring is released either by a push or by deinit.
+ */
+TEST_F(RingSchedulerTest, ParkedConsumer)
+{
+    uint32_t element = 0;
+    std::thread consumer([&]() { ASSERT_TRUE(scheduler_.pop(element)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler_.push(uint32_t(42), 0);
+    consumer.join();
+    ASSERT_EQ(element, 42u);
+
+    consumer = std::thread([&]() { ASSERT_FALSE(scheduler_.pop(element)); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    scheduler_.deinit();
+    consumer.join();
+}
+
+/*
+ * @brief Several producers and a single consumer, no element is lost nor duplicated.
+ */
+TEST_F(RingSchedulerTest, MultipleProducers)
+{
+    const uint32_t producers_count = 4;
+    const uint32_t elements_count = 100000;
+    RingScheduler<uint32_t> scheduler(producers_count * elements_count);
+    scheduler.init();
+
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < producers_count; ++p)
+    {
+        producers.emplace_back([&, p]()
+        {
+            for (uint32_t i = 0; i < elements_count; ++i)
+            {
+                scheduler.push(p * elements_count + i, 0);
+            }
+        });
+    }
+
+    std::vector<uint32_t> last_received(producers_count, 0);
+    std::vector<uint32_t> received(producers_count, 0);
+    uint32_t element;
+    for (uint32_t i = 0; i < producers_count * elements_count; ++i)
+    {
+        ASSERT_TRUE(scheduler.pop(element));
+        uint32_t producer = element / elements_count;
+        uint32_t value = element % elements_count;
+        if (0 != received[producer])
+        {
+            ASSERT_GT(value, last_received[producer]);
+        }
+        last_received[producer] = value;
+        ++received[producer];
+    }
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    for (uint32_t p = 0; p < producers_count; ++p)
+    {
+        ASSERT_EQ(received[p], elements_count);
+    }
+    scheduler.deinit();
+}
+
+/*
+ * @brief Consumers moving ahead while the occupancy is computed never make it reject an element.
+ */
+TEST_F(RingSchedulerTest, RejectByClassConcurrent)
+{
+    const uint32_t producers_count = 2;
+    const uint32_t elements_count = 50000;
+    std::atomic<uint32_t> dropped{0};
+    RingScheduler<uint32_t> scheduler(capacity_);
+    scheduler.set_overflow_policy(
+        OverflowPolicy::REJECT_BY_CLASS,
+        1,
+        [&](const uint32_t&, OverflowPolicy) { dropped.fetch_add(1); });
+    scheduler.init();
+
+    /* Each producer waits for its element to be consumed, so the ring never holds more than two. */
+    std::atomic<uint32_t> consumed{0};
+    std::vector<std::atomic<uint32_t>> pending(producers_count);
+    std::vector<std::thread> producers;
+    for (uint32_t p = 0; p < producers_count; ++p)
+    {
+        pending[p].store(0);
+        producers.emplace_back([&, p]()
+        {
+            for (uint32_t i = 0; i < elements_count; ++i)
+            {
+                pending[p].store(1);
+                scheduler.push(uint32_t(p), 0);
+                while ((0 != pending[p].load()) && (0 == dropped.load()))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    std::thread consumer([&]()
+    {
+        uint32_t element;
+        while ((consumed.load() < producers_count * elements_count) && (0 == dropped.load()))
+        {
+            if (scheduler.try_pop(element))
+            {
+                pending[element].store(0);
+                consumed.fetch_add(1);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (auto& producer : producers)
+    {
+        producer.join();
+    }
+    consumer.join();
+    ASSERT_EQ(dropped.load(), 0u);
+    ASSERT_EQ(consumed.load(), producers_count * elements_count);
+    scheduler.deinit();
+}
+
+class FCFSSchedulerTest : public ::testing::Test
+{
+protected:
+    FCFSSchedulerTest()
+        : scheduler_(8)
+    {
+        scheduler_.init();
+    }
+
+    ~FCFSSchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    FCFSScheduler<uint32_t> scheduler_;
+};
+
+TEST_F(FCFSSchedulerTest, Overflow)
+{
+    for (uint32_t i = 0; i < 10; ++i)
+    {
+        scheduler_.push(uint32_t(i), 0);
+    }
+
+    uint32_t element;
+    for (uint32_t i = 2; i < 10; ++i)
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, i);
+    }
+}
+
+/*
+ * @brief A batch takes the queued elements up to its size, try_pop never waits.
+ */
+TEST_F(FCFSSchedulerTest, PopBatch)
+{
+    for (uint32_t i = 0; i < 5; ++i)
+    {
+        scheduler_.push(uint32_t(i), 0);
+    }
+
+    std::vector<uint32_t> elements;
+    ASSERT_EQ(scheduler_.pop_batch(elements, 3), 3u);
+    ASSERT_EQ(scheduler_.pop_batch(elements, 3), 2u);
+    ASSERT_EQ(elements, std::vector<uint32_t>({0, 1, 2, 3, 4}));
+
+    uint32_t element;
+    ASSERT_FALSE(scheduler_.try_pop(element));
+    scheduler_.deinit();
+    ASSERT_EQ(scheduler_.pop_batch(elements, 3), 0u);
+}
+
+/*
+ * @brief The incoming element is discarded and reported to the drop handler.
+ */
+TEST_F(FCFSSchedulerTest, DropNewest)
+{
+    std::vector<uint32_t> dropped;
+    FCFSScheduler<uint32_t> scheduler(4);
+    scheduler.set_overflow_policy(
+        OverflowPolicy::DROP_NEWEST,
+        1,
+        [&](const uint32_t& element, OverflowPolicy policy)
+        {
+            ASSERT_EQ(policy, OverflowPolicy::DROP_NEWEST);
+            dropped.push_back(element);
+        });
+    scheduler.init();
+    for (uint32_t i = 0; i < 6; ++i)
+    {
+        scheduler.push(uint32_t(i), 0);
+    }
+    ASSERT_EQ(dropped, std::vector<uint32_t>({4, 5}));
+
+    uint32_t element;
+    ASSERT_TRUE(scheduler.pop(element));
+    ASSERT_EQ(element, 0u);
+    scheduler.deinit();
+}
+
+/*
+ * @brief Best-effort elements are discarded before any other.
+ */
+TEST_F(FCFSSchedulerTest, DropOldestBestEffort)
+{
+    std::vector<uint32_t> dropped;
+    FCFSScheduler<uint32_t> scheduler(4);
+    scheduler.set_overflow_policy(
+        OverflowPolicy::DROP_OLDEST_BEST_EFFORT,
+        3,
+        [&](const uint32_t& element, OverflowPolicy) { dropped.push_back(element); });
+    scheduler.init();
+    scheduler.push(uint32_t(0), 2);
+    scheduler.push(uint32_t(1), 0);
+    scheduler.push(uint32_t(2), 1);
+    scheduler.push(uint32_t(3), 0);
+    scheduler.push(uint32_t(4), 2);
+    scheduler.push(uint32_t(5), 2);
+    scheduler.push(uint32_t(6), 2);
+    ASSERT_EQ(dropped, std::vector<uint32_t>({1, 3, 0}));
+    scheduler.deinit();
+}
+
+/*
+ * @brief Each class is only admitted up to its share of the scheduler.
+ */
+TEST_F(FCFSSchedulerTest, RejectByClass)
+{
+    std::vector<uint32_t> dropped;
+    FCFSScheduler<uint32_t> scheduler(6);
+    scheduler.set_overflow_policy(
+        OverflowPolicy::REJECT_BY_CLASS,
+        3,
+        [&](const uint32_t& element, OverflowPolicy) { dropped.push_back(element); });
+    scheduler.init();
+    for (uint32_t i = 0; i < 3; ++i)
+    {
+        scheduler.push(uint32_t(i), 0);
+    }
+    for (uint32_t i = 10; i < 13; ++i)
+    {
+        scheduler.push(uint32_t(i), 1);
+    }
+    for (uint32_t i = 20; i < 23; ++i)
+    {
+        scheduler.push(uint32_t(i), 2);
+    }
+    ASSERT_EQ(dropped, std::vector<uint32_t>({2, 12, 22}));
+    scheduler.deinit();
+}
+
+/*
+ * @brief The producer waits until the consumer makes room.
+ */
+TEST_F(FCFSSchedulerTest, Block)
+{
+    FCFSScheduler<uint32_t> scheduler(2);
+    scheduler.set_overflow_policy(OverflowPolicy::BLOCK);
+    scheduler.init();
+
+    std::thread producer([&]()
+    {
+        for (uint32_t i = 0; i < 100; ++i)
+        {
+            scheduler.push(uint32_t(i), 0);
+        }
+    });
+
+    uint32_t element;
+    for (uint32_t i = 0; i < 100; ++i)
+    {
+        ASSERT_TRUE(scheduler.pop(element));
+        ASSERT_EQ(element, i);
+    }
+    producer.join();
+    scheduler.deinit();
+}
+
+class PrioritySchedulerTest : public ::testing::Test
+{
+protected:
+    PrioritySchedulerTest()
+        : scheduler_(8, 3)
+    {
+        scheduler_.init();
+    }
+
+    ~PrioritySchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    PriorityScheduler<uint32_t> scheduler_;
+};
+
+/*
+ * @brief Higher levels are served first, FCFS within each level.
+ */
+TEST_F(PrioritySchedulerTest, HigherPriorityFirst)
+{
+    scheduler_.push(uint32_t(0), 0);
+    scheduler_.push(uint32_t(1), 1);
+    scheduler_.push(uint32_t(2), 2);
+    scheduler_.push(uint32_t(3), 0);
+    scheduler_.push(uint32_t(4), 2);
+    scheduler_.push(uint32_t(5), 7);
+
+    uint32_t element;
+    for (uint32_t expected : {2, 4, 5, 1, 0, 3})
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, expected);
+    }
+}
+
+/*
+ * @brief Batches keep the order of single pops.
+ */
+TEST_F(PrioritySchedulerTest, PopBatch)
+{
+    scheduler_.push(uint32_t(0), 0);
+    scheduler_.push(uint32_t(1), 2);
+    scheduler_.push(uint32_t(2), 1);
+    scheduler_.push(uint32_t(3), 2);
+
+    std::vector<uint32_t> elements;
+    ASSERT_EQ(scheduler_.pop_batch(elements, 8), 4u);
+    ASSERT_EQ(elements, std::vector<uint32_t>({1, 3, 2, 0}));
+}
+
+/*
+ * @brief On overflow the lowest level loses its oldest element.
+ */
+TEST_F(PrioritySchedulerTest, Overflow)
+{
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        scheduler_.push(uint32_t(i), 0);
+    }
+    for (uint32_t i = 4; i < 10; ++i)
+    {
+        scheduler_.push(uint32_t(i), 2);
+    }
+
+    uint32_t element;
+    for (uint32_t expected : {4, 5, 6, 7, 8, 9, 2, 3})
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, expected);
+    }
+}
+
+class DRRSchedulerTest : public ::testing::Test
+{
+protected:
+    /* Elements encode the flow in the hundreds and the cost in the units. */
+    DRRSchedulerTest()
+        : scheduler_(
+            8,
+            10,
+            [](const uint32_t& element) { return element / 100; },
+            [](const uint32_t& element) { return size_t(element % 100); },
+            [](const uint32_t& flow) { return uint16_t((2 == flow) ? 2 : 1); })
+    {
+        scheduler_.init();
+    }
+
+    ~DRRSchedulerTest() override
+    {
+        scheduler_.deinit();
+    }
+
+    DRRScheduler<uint32_t, uint32_t> scheduler_;
+};
+
+/*
+ * @brief Flows are served in turns, a flow with double weight gets twice the bytes.
+ */
+TEST_F(DRRSchedulerTest, WeightedRoundRobin)
+{
+    for (uint32_t i = 0; i < 4; ++i)
+    {
+        scheduler_.push(uint32_t(110 + i), 0);
+        scheduler_.push(uint32_t(210 + i), 0);
+    }
+
+    uint32_t element;
+    for (uint32_t expected : {110, 210, 211, 212, 111, 213, 112, 113})
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, expected);
+    }
+}
+
+/*
+ * @brief On overflow the longest flow loses its oldest element.
+ */
+TEST_F(DRRSchedulerTest, Overflow)
+{
+    scheduler_.push(uint32_t(101), 0);
+    for (uint32_t i = 0; i < 8; ++i)
+    {
+        scheduler_.push(uint32_t(201 + i), 0);
+    }
+
+    uint32_t element;
+    for (uint32_t expected : {101, 202, 203, 204, 205, 206, 207, 208})
+    {
+        ASSERT_TRUE(scheduler_.pop(element));
+        ASSERT_EQ(element, expected);
+    }
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -14,6 +14,8 @@
 
 #include "../Common.h"
 
+#include <uxr/agent/message/ControlMessages.hpp>
+#include <uxr/agent/message/DataPayloadView.hpp>
 #include <uxr/agent/message/InputMessage.hpp>
 #include <uxr/agent/message/OutputMessage.hpp>
 
@@ -222,6 +224,32 @@ TEST_F(SerializerDeserializerTests, WriteDataSubmessage)
               deserialized_write_data.data().serialized_data());
 }
 
+TEST_F(SerializerDeserializerTests, WriteDataSubmessageView)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::WRITE_DATA_Payload_Data write_payload = generate_write_data_payload();
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          write_payload.getCdrSerializedSize();
+
+    OutputMessage output(message_header, message_size);
+    output.append_submessage(dds::xrce::WRITE_DATA, write_payload);
+
+    dds::xrce::BaseObjectRequest request;
+    const std::vector<uint8_t>& serialized_data = write_payload.data().serialized_data();
+    const uint8_t* data = nullptr;
+    InputMessage input(output.get_buf(), output.get_len());
+    ASSERT_TRUE(input.prepare_next_submessage());
+    ASSERT_TRUE(input.get_payload(request));
+    ASSERT_TRUE(input.get_raw_payload_view(data, serialized_data.size()));
+
+    ASSERT_EQ(write_payload.request_id(), request.request_id());
+    ASSERT_EQ(write_payload.object_id(), request.object_id());
+    ASSERT_EQ(serialized_data, std::vector<uint8_t>(data, data + serialized_data.size()));
+    ASSERT_FALSE(input.get_raw_payload_view(data, 1));
+}
+
 TEST_F(SerializerDeserializerTests, DataSubmessage)
 {
     dds::xrce::MessageHeader message_header = generate_message_header();
@@ -245,6 +273,41 @@ TEST_F(SerializerDeserializerTests, DataSubmessage)
     ASSERT_EQ(data_payload.data().serialized_data(), deserialized_data.data().serialized_data());
 }
 
+TEST_F(SerializerDeserializerTests, DataSubmessageView)
+{
+    dds::xrce::MessageHeader message_header = generate_message_header();
+    dds::xrce::DATA_Payload_Data data_payload = generate_data_payload_data();
+    const std::vector<uint8_t>& serialized_data = data_payload.data().serialized_data();
+    DataPayloadView data_view(
+        data_payload.request_id(), data_payload.object_id(), serialized_data.data(), serialized_data.size());
+    dds::xrce::SubmessageHeader submessage_header;
+    size_t message_size = message_header.getCdrSerializedSize() +
+                          submessage_header.getCdrSerializedSize() +
+                          data_payload.getCdrSerializedSize();
+    ASSERT_EQ(data_payload.getCdrSerializedSize(), data_view.getCdrSerializedSize());
+
+    OutputMessage output(message_header, message_size);
+    OutputMessage view_output(message_header, message_size);
+    ASSERT_TRUE(output.append_submessage(dds::xrce::DATA, data_payload));
+    ASSERT_TRUE(view_output.append_submessage(dds::xrce::DATA, data_view));
+
+    ASSERT_EQ(output.get_len(), view_output.get_len());
+    ASSERT_EQ(0, memcmp(output.get_buf(), view_output.get_buf(), output.get_len()));
+}
+
+TEST_F(SerializerDeserializerTests, SerializedSize)
+{
+    dds::xrce::HEARTBEAT_Payload heartbeat_payload;
+    dds::xrce::ACKNACK_Payload acknack_payload;
+    dds::xrce::STATUS_Payload status_payload = generate_resource_status_payload(dds::xrce::STATUS_OK, 0x00);
+    dds::xrce::DATA_Payload_Data data_payload = generate_data_payload_data();
+
+    ASSERT_EQ(heartbeat_payload.getCdrSerializedSize(), get_serialized_size(heartbeat_payload));
+    ASSERT_EQ(acknack_payload.getCdrSerializedSize(), get_serialized_size(acknack_payload));
+    ASSERT_EQ(status_payload.getCdrSerializedSize(), get_serialized_size(status_payload));
+    ASSERT_EQ(data_payload.getCdrSerializedSize(), get_serialized_size(data_payload));
+}
+
 TEST_F(SerializerDeserializerTests, DeleteSubmessage)
 {
     dds::xrce::MessageHeader message_header = generate_message_header();
@@ -266,6 +329,75 @@ TEST_F(SerializerDeserializerTests, DeleteSubmessage)
     ASSERT_EQ(delete_payload.request_id(), deserialized_data.request_id());
 }
 
+class ControlMessagesTests : public CommonData, public ::testing::Test
+{
+  protected:
+    const size_t mtu = 512;
+};
+
+/**
+ * @brief   This test checks that the patched templates match the serialized messages,
+ *          both with and without client key in the header.
+ */
+TEST_F(ControlMessagesTests, MatchSerialization)
+{
+    for (dds::xrce::SessionId id : {dds::xrce::SessionId(session_id), dds::xrce::SessionId(0x81)})
+    {
+        ControlMessages control_messages(SessionInfo{client_key, id, mtu});
+
+        dds::xrce::MessageHeader header;
+        header.session_id(id);
+        header.stream_id(dds::xrce::STREAMID_NONE);
+        header.sequence_nr(0x00);
+        header.client_key(client_key);
+
+        dds::xrce::ACKNACK_Payload acknack;
+        acknack.first_unacked_seq_num(0xFF01);
+        acknack.nack_bitmap({0xA5, 0x3C});
+        acknack.stream_id(0x85);
+
+        OutputMessage expected_acknack(header, mtu);
+        expected_acknack.append_submessage(dds::xrce::ACKNACK, acknack);
+        std::shared_ptr<OutputMessage> output_acknack = control_messages.create_acknack(acknack);
+        ASSERT_EQ(output_acknack->get_len(), expected_acknack.get_len());
+        ASSERT_EQ(0, memcmp(output_acknack->get_buf(), expected_acknack.get_buf(), expected_acknack.get_len()));
+
+        std::vector<dds::xrce::HEARTBEAT_Payload> heartbeats(3);
+        OutputMessage expected_heartbeats(header, mtu);
+        for (size_t i = 0; i < heartbeats.size(); ++i)
+        {
+            heartbeats[i].first_unacked_seq_nr(uint16_t(0x1234 + i));
+            heartbeats[i].last_unacked_seq_nr(uint16_t(0xFFFE + i));
+            heartbeats[i].stream_id(uint8_t(0x80 + i));
+            expected_heartbeats.append_submessage(dds::xrce::HEARTBEAT, heartbeats[i]);
+        }
+        size_t index = 0;
+        std::shared_ptr<OutputMessage> output_heartbeats = control_messages.create_heartbeats(heartbeats, index);
+        ASSERT_EQ(index, heartbeats.size());
+        ASSERT_EQ(output_heartbeats->get_len(), expected_heartbeats.get_len());
+        ASSERT_EQ(0, memcmp(output_heartbeats->get_buf(), expected_heartbeats.get_buf(), expected_heartbeats.get_len()));
+    }
+}
+
+/**
+ * @brief   This test checks that HEARTBEATs are split in several messages according to the MTU.
+ */
+TEST_F(ControlMessagesTests, HeartbeatsMTU)
+{
+    /* 8 bytes of header plus two HEARTBEATs of 9 bytes with 3 bytes of padding in between. */
+    const size_t heartbeats_mtu = 29;
+    ControlMessages control_messages(SessionInfo{client_key, session_id, heartbeats_mtu});
+
+    std::vector<dds::xrce::HEARTBEAT_Payload> heartbeats(5);
+    size_t index = 0;
+    std::vector<size_t> lengths;
+    while (index < heartbeats.size())
+    {
+        lengths.push_back(control_messages.create_heartbeats(heartbeats, index)->get_len());
+    }
+    ASSERT_EQ(lengths, std::vector<size_t>({29, 29, 17}));
+}
+
 } // namespace testing
 } // namespace uxr
 } // namespace eprosima
@@ -0,0 +1,173 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/BufferPool.hpp>
+#include <uxr/agent/utils/PoolAllocator.hpp>
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+TEST(BufferPoolTest, Reuse)
+{
+    utils::BufferPool pool(64, 2);
+    uint8_t* data = nullptr;
+    {
+        utils::PooledBuffer buffer = pool.acquire();
+        ASSERT_TRUE(bool(buffer));
+        ASSERT_EQ(buffer.size(), 64u);
+        data = buffer.data();
+    }
+    utils::PooledBuffer buffer = pool.acquire();
+    ASSERT_EQ(buffer.data(), data);
+    ASSERT_EQ(pool.get_allocations(), 1u);
+    ASSERT_EQ(pool.get_acquisitions(), 2u);
+}
+
+/*
+ * @brief Moved buffers are given back once, and only up to max_free_buffers are kept.
+ */
+TEST(BufferPoolTest, Ownership)
+{
+    utils::BufferPool pool(64, 2);
+    {
+        std::vector<utils::PooledBuffer> buffers;
+        for (int i = 0; i < 4; ++i)
+        {
+            buffers.push_back(pool.acquire());
+        }
+        utils::PooledBuffer moved = std::move(buffers.front());
+        ASSERT_FALSE(bool(buffers.front()));
+        ASSERT_TRUE(bool(moved));
+        moved.reset();
+        ASSERT_FALSE(bool(moved));
+    }
+    ASSERT_EQ(pool.get_allocations(), 4u);
+
+    std::vector<utils::PooledBuffer> buffers;
+    for (int i = 0; i < 4; ++i)
+    {
+        buffers.push_back(pool.acquire());
+    }
+    ASSERT_EQ(pool.get_allocations(), 6u);
+}
+
+/*
+ * @brief Buffers acquired and released from several threads, the pool stops allocating.
+ */
+TEST(BufferPoolTest, Concurrency)
+{
+    const size_t threads_count = 4;
+    utils::BufferPool pool(64, threads_count * 8);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < threads_count; ++t)
+    {
+        threads.emplace_back([&pool, t]()
+        {
+            for (int i = 0; i < 10000; ++i)
+            {
+                std::vector<utils::PooledBuffer> buffers;
+                for (int j = 0; j < 8; ++j)
+                {
+                    buffers.push_back(pool.acquire());
+                    buffers.back().data()[0] = uint8_t(t);
+                }
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_LE(pool.get_allocations(), threads_count * 8);
+    ASSERT_EQ(pool.get_acquisitions(), threads_count * 8 * 10000);
+}
+
+/*
+ * @brief Buffers released by a thread are reused by another one, whatever their shards.
+ */
+TEST(BufferPoolTest, CrossThreadReuse)
+{
+    utils::BufferPool pool(64, 4);
+    std::vector<utils::PooledBuffer> buffers;
+    for (int i = 0; i < 4; ++i)
+    {
+        buffers.push_back(pool.acquire());
+    }
+    std::thread([&buffers]()
+    {
+        buffers.clear();
+    }).join();
+
+    std::thread([&pool, &buffers]()
+    {
+        for (int i = 0; i < 4; ++i)
+        {
+            buffers.push_back(pool.acquire());
+        }
+    }).join();
+    ASSERT_EQ(pool.get_allocations(), 4u);
+    ASSERT_EQ(pool.get_acquisitions(), 8u);
+}
+
+/*
+ * @brief allocate_shared places the object and its control block in a single pooled buffer.
+ */
+TEST(BufferPoolTest, PoolAllocator)
+{
+    struct Object
+    {
+        uint64_t values[4];
+    };
+
+    utils::BufferPool pool(sizeof(Object) + 64, 2);
+    for (int i = 0; i < 100; ++i)
+    {
+        std::shared_ptr<Object> object = std::allocate_shared<Object>(utils::PoolAllocator<Object>(pool));
+        std::weak_ptr<Object> observer = object;
+        object->values[0] = uint64_t(i);
+    }
+    ASSERT_EQ(pool.get_allocations(), 1u);
+    ASSERT_EQ(pool.get_acquisitions(), 100u);
+}
+
+/*
+ * @brief Objects larger than the buffers of the pool come from the heap and are accounted for.
+ */
+TEST(BufferPoolTest, PoolAllocatorFallback)
+{
+    struct Object
+    {
+        uint64_t values[16];
+    };
+
+    utils::BufferPool pool(sizeof(Object) / 2, 2);
+    for (int i = 0; i < 10; ++i)
+    {
+        std::shared_ptr<Object> object = std::allocate_shared<Object>(utils::PoolAllocator<Object>(pool));
+        object->values[0] = uint64_t(i);
+    }
+    ASSERT_EQ(pool.get_allocations(), 10u);
+    ASSERT_EQ(pool.get_acquisitions(), 0u);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
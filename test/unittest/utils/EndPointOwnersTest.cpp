@@ -0,0 +1,74 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/transport/util/EndPointOwners.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using util::EndPointOwners;
+
+/*
+ * @brief Unknown endpoints are reached through the first receiver, known ones through the last one they used.
+ */
+TEST(EndPointOwnersTest, GetAndSet)
+{
+    EndPointOwners<IPv4EndPoint> owners(4096);
+    const IPv4EndPoint endpoint(0x0100007F, 2019);
+    ASSERT_EQ(owners.get(endpoint), 0u);
+
+    owners.set(endpoint, 3);
+    ASSERT_EQ(owners.get(endpoint), 3u);
+    owners.set(endpoint, 1);
+    ASSERT_EQ(owners.get(endpoint), 1u);
+
+    const IPv6EndPoint endpoint_v6({{0xFE, 0x80, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1}}, 2019);
+    EndPointOwners<IPv6EndPoint> owners_v6(4096);
+    owners_v6.set(endpoint_v6, 2);
+    ASSERT_EQ(owners_v6.get(endpoint_v6), 2u);
+
+    owners.clear();
+    ASSERT_EQ(owners.get(endpoint), 0u);
+}
+
+/*
+ * @brief A full stripe forgets its least recently heard endpoint only.
+ */
+TEST(EndPointOwnersTest, LeastRecentlyHeardEviction)
+{
+    /* Two endpoints per stripe. Ports 64 apart fall in the same stripe. */
+    EndPointOwners<IPv4EndPoint> owners(2 * EndPointOwners<IPv4EndPoint>::STRIPES);
+    const IPv4EndPoint first(0x0100007F, 2000);
+    const IPv4EndPoint second(0x0100007F, 2000 + 64);
+    const IPv4EndPoint third(0x0100007F, 2000 + 128);
+    const IPv4EndPoint other(0x0100007F, 2001);
+
+    owners.set(first, 1);
+    owners.set(second, 2);
+    owners.set(other, 3);
+    owners.set(first, 1);
+    owners.set(third, 4);
+
+    ASSERT_EQ(owners.get(first), 1u);
+    ASSERT_EQ(owners.get(second), 0u);
+    ASSERT_EQ(owners.get(third), 4u);
+    ASSERT_EQ(owners.get(other), 3u);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
@@ -0,0 +1,94 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/LatencyHistogram.hpp>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+using std::chrono::nanoseconds;
+
+TEST(LatencyHistogramTest, Empty)
+{
+    utils::LatencyHistogram histogram;
+    ASSERT_EQ(histogram.get_count(), 0u);
+    ASSERT_EQ(histogram.get_percentile(50.0), nanoseconds(0));
+}
+
+TEST(LatencyHistogramTest, ExactSmallValues)
+{
+    utils::LatencyHistogram histogram;
+    for (int64_t i = 1; i <= 10; ++i)
+    {
+        histogram.record(nanoseconds(i));
+    }
+    ASSERT_EQ(histogram.get_count(), 10u);
+    ASSERT_EQ(histogram.get_percentile(0.0), nanoseconds(1));
+    ASSERT_EQ(histogram.get_percentile(50.0), nanoseconds(5));
+    ASSERT_EQ(histogram.get_percentile(100.0), nanoseconds(10));
+
+    histogram.reset();
+    ASSERT_EQ(histogram.get_count(), 0u);
+}
+
+/*
+ * @brief Percentiles are bounded from above with a relative error below 12.5%.
+ */
+TEST(LatencyHistogramTest, RelativeError)
+{
+    utils::LatencyHistogram histogram;
+    for (int64_t i = 1; i <= 100000; ++i)
+    {
+        histogram.record(nanoseconds(i * 1000));
+    }
+
+    for (double percentile : {1.0, 50.0, 90.0, 99.0, 99.9})
+    {
+        const double expected = percentile * 1000000.0;
+        const double actual = double(histogram.get_percentile(percentile).count());
+        ASSERT_GE(actual, expected);
+        ASSERT_LE(actual, expected * 1.125);
+    }
+}
+
+TEST(LatencyHistogramTest, ConcurrentRecords)
+{
+    utils::LatencyHistogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&]()
+        {
+            for (int64_t i = 0; i < 10000; ++i)
+            {
+                histogram.record(nanoseconds(i));
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+    ASSERT_EQ(histogram.get_count(), 40000u);
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
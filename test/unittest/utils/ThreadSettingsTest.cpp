@@ -0,0 +1,123 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/ArgumentParser.hpp>
+
+#include <gtest/gtest.h>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class ThreadSettingsTest : public ::testing::Test
+{
+protected:
+    ThreadSettingsTest() = default;
+    ~ThreadSettingsTest() override = default;
+
+    bool parse(
+            const std::string& affinity,
+            const std::string& priority)
+    {
+        return agent::parser::utils::get_thread_settings(affinity, priority, settings_);
+    }
+
+    const ThreadSettings& get(ThreadKind kind) const
+    {
+        return settings_[size_t(kind)];
+    }
+
+    std::array<ThreadSettings, THREAD_KIND_COUNT> settings_;
+};
+
+TEST_F(ThreadSettingsTest, valid_settings)
+{
+    ASSERT_TRUE(parse("recv=2:proc=3-5,7", "recv=80:proc=70"));
+
+    EXPECT_EQ(std::vector<uint16_t>({2}), get(ThreadKind::RECEIVER).cpus);
+    EXPECT_EQ(80, get(ThreadKind::RECEIVER).priority);
+    EXPECT_EQ(std::vector<uint16_t>({3, 4, 5, 7}), get(ThreadKind::PROCESSING).cpus);
+    EXPECT_EQ(70, get(ThreadKind::PROCESSING).priority);
+
+    /* Kinds not given keep the defaults. */
+    EXPECT_TRUE(get(ThreadKind::SENDER).cpus.empty());
+    EXPECT_EQ(0, get(ThreadKind::SENDER).priority);
+
+    ASSERT_TRUE(parse("hb=0:rd=1:disc=2:aux=1023", "send=1:hb=99"));
+    EXPECT_EQ(std::vector<uint16_t>({0}), get(ThreadKind::HEARTBEAT).cpus);
+    EXPECT_EQ(std::vector<uint16_t>({1}), get(ThreadKind::READER).cpus);
+    EXPECT_EQ(std::vector<uint16_t>({2}), get(ThreadKind::DISCOVERY).cpus);
+    EXPECT_EQ(std::vector<uint16_t>({1023}), get(ThreadKind::AUXILIARY).cpus);
+    EXPECT_EQ(1, get(ThreadKind::SENDER).priority);
+    EXPECT_EQ(99, get(ThreadKind::HEARTBEAT).priority);
+}
+
+TEST_F(ThreadSettingsTest, all_kinds)
+{
+    ASSERT_TRUE(parse("all=1", "all=10:proc=20"));
+    for (const ThreadSettings& settings : settings_)
+    {
+        EXPECT_EQ(std::vector<uint16_t>({1}), settings.cpus);
+    }
+    EXPECT_EQ(10, get(ThreadKind::RECEIVER).priority);
+    EXPECT_EQ(20, get(ThreadKind::PROCESSING).priority);
+}
+
+TEST_F(ThreadSettingsTest, empty_strings)
+{
+    ASSERT_TRUE(parse("recv=2", "recv=80"));
+
+    /* Parsing again resets the previous settings. */
+    ASSERT_TRUE(parse("", ""));
+    for (const ThreadSettings& settings : settings_)
+    {
+        EXPECT_TRUE(settings.cpus.empty());
+        EXPECT_EQ(0, settings.priority);
+    }
+}
+
+TEST_F(ThreadSettingsTest, unknown_kinds)
+{
+    EXPECT_FALSE(parse("foo=1", ""));
+    EXPECT_FALSE(parse("", "foo=1"));
+    EXPECT_FALSE(parse("recv=1:RECV=2", ""));
+}
+
+TEST_F(ThreadSettingsTest, malformed_entries)
+{
+    EXPECT_FALSE(parse("recv", ""));
+    EXPECT_FALSE(parse("recv=", ""));
+    EXPECT_FALSE(parse("=1", ""));
+    EXPECT_FALSE(parse("recv=a", ""));
+    EXPECT_FALSE(parse("recv=-1", ""));
+    EXPECT_FALSE(parse("recv=1-", ""));
+    EXPECT_FALSE(parse("recv=5-3", ""));
+    EXPECT_FALSE(parse("", "proc"));
+    EXPECT_FALSE(parse("", "proc="));
+    EXPECT_FALSE(parse("", "proc=1.5"));
+    EXPECT_FALSE(parse("", "proc=-1"));
+}
+
+TEST_F(ThreadSettingsTest, out_of_range_values)
+{
+    EXPECT_FALSE(parse("recv=1024", ""));
+    EXPECT_FALSE(parse("recv=0-1024", ""));
+    EXPECT_FALSE(parse("recv=99999999999999999999", ""));
+    EXPECT_FALSE(parse("", "recv=100"));
+    EXPECT_FALSE(parse("", "recv=99999999999999999999"));
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima
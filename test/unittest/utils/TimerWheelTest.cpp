@@ -0,0 +1,162 @@
+// Copyright 2020 Proyectos y Sistemas de Mantenimiento SL (eProsima).
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <uxr/agent/utils/TimerWheel.hpp>
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace eprosima {
+namespace uxr {
+namespace testing {
+
+class TimerWheelTest : public ::testing::Test
+{
+protected:
+    std::vector<uint64_t> advance(
+            uint64_t now)
+    {
+        std::vector<uint64_t> expired;
+        wheel_.advance(now, [&](uint64_t key) { expired.push_back(key); });
+        return expired;
+    }
+
+    utils::TimerWheel wheel_;
+};
+
+TEST_F(TimerWheelTest, ExpireAtDeadline)
+{
+    ASSERT_TRUE(wheel_.arm(1, 10));
+    ASSERT_TRUE(wheel_.arm(2, 200));
+    ASSERT_TRUE(wheel_.arm(3, 5000));
+    ASSERT_EQ(wheel_.size(), 3u);
+
+    ASSERT_TRUE(advance(9).empty());
+    ASSERT_EQ(advance(10), std::vector<uint64_t>({1}));
+    ASSERT_TRUE(advance(199).empty());
+    ASSERT_EQ(advance(4999), std::vector<uint64_t>({2}));
+    ASSERT_EQ(advance(6000), std::vector<uint64_t>({3}));
+    ASSERT_EQ(wheel_.size(), 0u);
+}
+
+/*
+ * @brief An armed timer keeps its deadline, a disarmed one never expires.
+ */
+TEST_F(TimerWheelTest, ArmAndDisarm)
+{
+    ASSERT_TRUE(wheel_.arm(1, 100));
+    ASSERT_FALSE(wheel_.arm(1, 50));
+    ASSERT_TRUE(wheel_.is_armed(1));
+    ASSERT_TRUE(advance(99).empty());
+    ASSERT_EQ(advance(100), std::vector<uint64_t>({1}));
+
+    ASSERT_TRUE(wheel_.arm(2, 300));
+    ASSERT_TRUE(wheel_.disarm(2));
+    ASSERT_FALSE(wheel_.disarm(2));
+    ASSERT_TRUE(wheel_.arm(2, 400));
+    ASSERT_TRUE(advance(399).empty());
+    ASSERT_EQ(advance(400), std::vector<uint64_t>({2}));
+}
+
+/*
+ * @brief Past deadlines expire on the next tick and the callback may arm again.
+ */
+TEST_F(TimerWheelTest, Rearm)
+{
+    advance(1000);
+    ASSERT_TRUE(wheel_.arm(7, 10));
+    std::vector<uint64_t> expirations;
+    for (uint64_t now = 1001; now <= 1100; ++now)
+    {
+        wheel_.advance(now, [&](uint64_t key)
+        {
+            expirations.push_back(wheel_.now());
+            wheel_.arm(key, wheel_.now() + 25);
+        });
+    }
+    ASSERT_EQ(expirations, std::vector<uint64_t>({1001, 1026, 1051, 1076}));
+}
+
+/*
+ * @brief Random arms and disarms against a reference model.
+ */
+TEST_F(TimerWheelTest, Reference)
+{
+    std::mt19937_64 rng(42);
+    std::map<uint64_t, uint64_t> reference;
+    uint64_t now = 0;
+    while (now < 1000000)
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            uint64_t key = rng() % 512;
+            if (0 == rng() % 4)
+            {
+                ASSERT_EQ(wheel_.disarm(key), 0 != reference.erase(key));
+            }
+            else
+            {
+                uint64_t deadline = now + 1 + rng() % ((0 == rng() % 8) ? 300000 : 3000);
+                bool armed = wheel_.arm(key, deadline);
+                ASSERT_EQ(armed, reference.end() == reference.find(key));
+                if (armed)
+                {
+                    reference.emplace(key, deadline);
+                }
+            }
+        }
+
+        uint64_t target = now + 1 + rng() % 700;
+        std::multimap<uint64_t, uint64_t> by_deadline;
+        for (auto it = reference.begin(); it != reference.end();)
+        {
+            if (it->second <= target)
+            {
+                by_deadline.emplace(it->second, it->first);
+                it = reference.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        std::map<uint64_t, std::vector<uint64_t>> expired;
+        wheel_.advance(target, [&](uint64_t key) { expired[wheel_.now()].push_back(key); });
+        std::map<uint64_t, std::vector<uint64_t>> expected_expired;
+        for (const auto& entry : by_deadline)
+        {
+            expected_expired[entry.first].push_back(entry.second);
+        }
+        for (auto& entry : expired)
+        {
+            std::sort(entry.second.begin(), entry.second.end());
+        }
+        for (auto& entry : expected_expired)
+        {
+            std::sort(entry.second.begin(), entry.second.end());
+        }
+        ASSERT_EQ(expired, expected_expired);
+        ASSERT_EQ(wheel_.size(), reference.size());
+        now = target;
+    }
+}
+
+} // namespace testing
+} // namespace uxr
+} // namespace eprosima